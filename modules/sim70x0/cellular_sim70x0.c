@@ -27,6 +27,7 @@
 
 
 #include <stdint.h>
+#include <string.h>
 #include "cellular_platform.h"
 #include "cellular_config.h"
 #include "cellular_config_defaults.h"
@@ -36,13 +37,77 @@
 
 /*-----------------------------------------------------------*/
 
+/* rxDataEvent keeps one bit per socket. FreeRTOS event groups have 24 usable bits. */
+#if ( CELLULAR_NUM_SOCKET_MAX > 24 )
+    #error "CELLULAR_NUM_SOCKET_MAX exceeds the bits available in rxDataEvent."
+#endif
+
+#if ( CELLULAR_SIM70X0_DNS_MAX_QUERIES > 24 )
+    #error "CELLULAR_SIM70X0_DNS_MAX_QUERIES exceeds the bits available in dnsEvent."
+#endif
+
+/* pdnEvent keeps one PDN_EVENT_BIT per CID above the module event bits. */
+#if ( CELLULAR_CID_MAX > 15 )
+    #error "CELLULAR_CID_MAX exceeds the bits available in pdnEvent."
+#endif
+
 #define ENBABLE_MODULE_UE_RETRY_COUNT      ( 3U )
 #define ENBABLE_MODULE_UE_RETRY_TIMEOUT    ( 5000U )
 
+/* Room for the CR appended by the common library and the terminator. */
+#define AT_BATCH_LINE_MAX                  ( CELLULAR_AT_CMD_MAX_SIZE - 2U )
+
+/* Settings sent by Cellular_ModuleEnableUE, AT+CFUN=1 included. */
+#define STARTUP_CMD_COUNT                  ( 8U )
+
+/* startupDiffSend and cellularStartupStats_t hold one entry per setting. */
+#if ( STARTUP_CMD_COUNT > CELLULAR_SIM70X0_STARTUP_CMD_MAX )
+    #error "STARTUP_CMD_COUNT exceeds CELLULAR_SIM70X0_STARTUP_CMD_MAX."
+#endif
+
+#if ( CELLULAR_SIM70X0_STARTUP_DIFF != 0 )
+
+/* Setting compared by startupDiffSend. "AT+IFC=2,2" is read with "+IFC?"
+ * and matches "+IFC: 2,2". */
+    typedef struct startupSetting
+    {
+        const char * pAtCmd;
+        char query[ 16 ];       /* "+IFC", empty if the setting can't be read back. */
+        const char * pValue;    /* "2,2", quotes are ignored. */
+        bool differs;
+    } startupSetting_t;
+#endif
+
 /*-----------------------------------------------------------*/
 
 static CellularError_t sendAtCommandWithRetryTimeout( CellularContext_t * pContext,
                                                       const CellularAtReq_t * pAtReq );
+static CellularError_t sendAtCommandTries( CellularContext_t * pContext,
+                                           const CellularAtReq_t * pAtReq,
+                                           uint32_t timeoutMs,
+                                           uint8_t tryCount );
+static uint32_t atBatchBuildLine( const cellularAtBatchCmd_t * pCmds,
+                                  uint32_t numCmds,
+                                  char * pLine );
+static void moduleWorkerThread( void * pArgument );
+static CellularError_t createSocketModuleData( cellularModuleContext_t * pModuleContext );
+static void destroySocketModuleData( cellularModuleContext_t * pModuleContext );
+static void runSocketCallback( const cellularCallbackEvent_t * pEvent );
+static CellularError_t startCallbackTask( cellularModuleContext_t * pModuleContext );
+static void stopCallbackTask( cellularModuleContext_t * pModuleContext );
+#if ( CELLULAR_SIM70X0_DEFER_CALLBACKS != 0 )
+    static void moduleCallbackThread( void * pArgument );
+#endif
+#if ( CELLULAR_SIM70X0_STARTUP_DIFF != 0 )
+    static CellularPktStatus_t startupReadCb( CellularContext_t * pContext,
+                                              const CellularATCommandResponse_t * pAtResp,
+                                              void * pData,
+                                              uint16_t dataLen );
+    static CellularError_t startupDiffSend( CellularContext_t * pContext,
+                                           cellularAtBatchCmd_t * pCmds,
+                                           uint32_t numCmds,
+                                           uint32_t cmdMs );
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -104,6 +169,637 @@ static CellularError_t sendAtCommandWithRetryTimeout( CellularContext_t * pConte
 
 /*-----------------------------------------------------------*/
 
+static CellularError_t sendAtCommandTries( CellularContext_t * pContext,
+                                           const CellularAtReq_t * pAtReq,
+                                           uint32_t timeoutMs,
+                                           uint8_t tryCount )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint8_t i = 0;
+
+    for( i = 0; ( i == 0U ) || ( ( i < tryCount ) && ( cellularStatus != CELLULAR_SUCCESS ) ); i++ )
+    {
+        cellularStatus = _Cellular_TranslatePktStatus(
+            _Cellular_TimeoutAtcmdRequestWithCallback( pContext, *pAtReq, timeoutMs ) );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Concatenate pCmds from the first into pLine while they fit. A ';' is only
+ * needed after an extended command. Returns the number of commands taken,
+ * 0 if the first one isn't an AT command or is too long. */
+static uint32_t atBatchBuildLine( const cellularAtBatchCmd_t * pCmds,
+                                  uint32_t numCmds,
+                                  char * pLine )
+{
+    uint32_t lineLen = 2U;
+    uint32_t cmdLen = 0;
+    uint32_t sepLen = 0;
+    uint32_t count = 0;
+    const char * pBody = NULL;
+    bool extended = false;
+
+    ( void ) memcpy( pLine, "AT", 3U );
+
+    for( count = 0; count < numCmds; count++ )
+    {
+        if( ( pCmds[ count ].pAtCmd == NULL ) || ( strncmp( pCmds[ count ].pAtCmd, "AT", 2U ) != 0 ) )
+        {
+            break;
+        }
+
+        pBody = &pCmds[ count ].pAtCmd[ 2 ];
+        cmdLen = ( uint32_t ) strlen( pBody );
+        sepLen = ( extended == true ) ? 1U : 0U;
+
+        if( ( lineLen + sepLen + cmdLen ) > AT_BATCH_LINE_MAX )
+        {
+            break;
+        }
+
+        if( sepLen != 0U )
+        {
+            pLine[ lineLen ] = ';';
+        }
+
+        ( void ) memcpy( &pLine[ lineLen + sepLen ], pBody, cmdLen + 1U );
+        lineLen = lineLen + sepLen + cmdLen;
+        extended = ( pBody[ 0 ] == '+' );
+    }
+
+    return count;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t _Cellular_AtBatchSend( CellularContext_t * pContext,
+                                       cellularAtBatchCmd_t * pCmds,
+                                       uint32_t numCmds,
+                                       uint32_t timeoutMs,
+                                       uint8_t tryCount )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularError_t lineStatus = CELLULAR_SUCCESS;
+    char line[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+    uint32_t first = 0;
+    uint32_t count = 0;
+    uint32_t i = 0;
+    CellularAtReq_t atReq =
+    {
+        line,
+        CELLULAR_AT_MULTI_WO_PREFIX,
+        NULL,
+        NULL,
+        NULL,
+        0
+    };
+
+    if( ( pContext == NULL ) || ( pCmds == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+
+    for( first = 0; ( pCmds != NULL ) && ( first < numCmds ); first += count )
+    {
+        count = atBatchBuildLine( &pCmds[ first ], numCmds - first, line );
+        lineStatus = CELLULAR_UNKNOWN;
+
+        if( count > 1U )
+        {
+            /* One round trip for the whole line. */
+            lineStatus = _Cellular_TranslatePktStatus(
+                _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReq, timeoutMs * count ) );
+
+            if( lineStatus != CELLULAR_SUCCESS )
+            {
+                LogDebug( ( "_Cellular_AtBatchSend: %s failed, sending its commands one by one", line ) );
+            }
+        }
+        else
+        {
+            /* A single command, or one that can't be concatenated, is sent as it is. */
+            count = 1U;
+        }
+
+        for( i = first; i < ( first + count ); i++ )
+        {
+            if( lineStatus == CELLULAR_SUCCESS )
+            {
+                pCmds[ i ].status = CELLULAR_SUCCESS;
+            }
+            else if( ( pContext == NULL ) || ( pCmds[ i ].pAtCmd == NULL ) )
+            {
+                pCmds[ i ].status = CELLULAR_BAD_PARAMETER;
+            }
+            else
+            {
+                atReq.pAtCmd = pCmds[ i ].pAtCmd;
+                pCmds[ i ].status = sendAtCommandTries( pContext, &atReq, timeoutMs, tryCount );
+                atReq.pAtCmd = line;
+            }
+
+            if( ( cellularStatus == CELLULAR_SUCCESS ) && ( pCmds[ i ].status != CELLULAR_SUCCESS ) )
+            {
+                LogError( ( "_Cellular_AtBatchSend: %s failed %d", pCmds[ i ].pAtCmd, pCmds[ i ].status ) );
+                cellularStatus = pCmds[ i ].status;
+            }
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void moduleWorkerThread( void * pArgument )
+{
+    cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pArgument;
+    cellularWorkerJob_t job = { 0 };
+    bool exitWorker = false;
+    CellularContext_t * pTxContext = NULL;
+    TickType_t waitTicks = portMAX_DELAY;
+    TickType_t txWaitTicks = portMAX_DELAY;
+    TickType_t pdnWaitTicks = portMAX_DELAY;
+
+    while( exitWorker == false )
+    {
+        /* Wake up for the next job, the earliest coalesced send deadline, DNS or PDN activation timeout. */
+        if( xQueueReceive( pModuleContext->workerQueue, &job, waitTicks ) == pdTRUE )
+        {
+            switch( job.jobType )
+            {
+                case WORKER_JOB_RX_FETCH:
+                    pModuleContext->socketData[ job.socketId ].rxFetchQueued = false;
+                    ( void ) _Cellular_SocketRxFetch( job.pContext, job.socketId );
+                    break;
+
+                case WORKER_JOB_TX_TIMER:
+                    pTxContext = job.pContext;
+                    break;
+
+                case WORKER_JOB_SEND:
+                    _Cellular_SocketSendAsyncJob( job.pContext, job.socketId );
+                    break;
+
+                case WORKER_JOB_DNS_TIMER:
+                case WORKER_JOB_PDN_TIMER:
+                    break;
+
+                case WORKER_JOB_EXIT:
+                default:
+                    exitWorker = true;
+                    break;
+            }
+        }
+
+        if( exitWorker == false )
+        {
+            waitTicks = _Cellular_DnsQueryDispatch( pModuleContext );
+            pdnWaitTicks = _Cellular_PdnActivateDispatch( pModuleContext );
+            waitTicks = ( pdnWaitTicks < waitTicks ) ? pdnWaitTicks : waitTicks;
+
+            if( pTxContext != NULL )
+            {
+                txWaitTicks = _Cellular_SocketTxFlushExpired( pTxContext, pModuleContext );
+                waitTicks = ( txWaitTicks < waitTicks ) ? txWaitTicks : waitTicks;
+            }
+        }
+    }
+
+    LogDebug( ( "moduleWorkerThread: exit" ) );
+    ( void ) xEventGroupSetBits( pModuleContext->pdnEvent, EVENT_BIT_WORKER_EXITED );
+}
+
+/*-----------------------------------------------------------*/
+
+bool _Cellular_PostWorkerJob( cellularModuleContext_t * pModuleContext,
+                              const cellularWorkerJob_t * pJob )
+{
+    bool status = false;
+
+    if( ( pModuleContext != NULL ) && ( pJob != NULL ) && ( pModuleContext->workerQueue != NULL ) )
+    {
+        /* Never block. Jobs are posted from the URC context. */
+        if( xQueueSend( pModuleContext->workerQueue, pJob, ( TickType_t ) 0 ) == pdPASS )
+        {
+            status = true;
+        }
+        else
+        {
+            LogWarn( ( "_Cellular_PostWorkerJob: worker queue full, job %d dropped", pJob->jobType ) );
+        }
+    }
+
+    return status;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_RequestRxFetch( CellularContext_t * pContext,
+                               cellularModuleContext_t * pModuleContext,
+                               uint32_t socketId )
+{
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    cellularWorkerJob_t job = { WORKER_JOB_RX_FETCH, NULL, 0, NULL };
+
+    if( ( pModuleContext != NULL ) && ( socketId < CELLULAR_NUM_SOCKET_MAX ) )
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketId ];
+
+        /* One queued fetch per socket is enough. It drains the modem until +CARECV: 0. */
+        if( ( pSocketModuleData->pRxRing != NULL ) && ( pSocketModuleData->rxFetchQueued == false ) )
+        {
+            job.pContext = pContext;
+            job.socketId = socketId;
+            pSocketModuleData->rxFetchQueued = true;
+
+            if( _Cellular_PostWorkerJob( pModuleContext, &job ) == false )
+            {
+                pSocketModuleData->rxFetchQueued = false;
+            }
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+bool _Cellular_SocketPin( cellularModuleContext_t * pModuleContext,
+                          uint32_t socketId,
+                          uint32_t generation )
+{
+    cellularSocketModuleData_t * pSocketModuleData = &pModuleContext->socketData[ socketId ];
+    bool pinned = false;
+
+    ( void ) xSemaphoreTake( pModuleContext->socketLock, portMAX_DELAY );
+
+    if( ( pSocketModuleData->generation == generation ) && ( pSocketModuleData->removePending == false ) )
+    {
+        pSocketModuleData->callbackRefs++;
+        pinned = true;
+    }
+
+    ( void ) xSemaphoreGive( pModuleContext->socketLock );
+
+    return pinned;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SocketUnpin( cellularModuleContext_t * pModuleContext,
+                            uint32_t socketId )
+{
+    cellularSocketModuleData_t * pSocketModuleData = &pModuleContext->socketData[ socketId ];
+
+    ( void ) xSemaphoreTake( pModuleContext->socketLock, portMAX_DELAY );
+
+    pSocketModuleData->callbackRefs--;
+
+    /* Cellular_SocketClose ran meanwhile, possibly from the callback itself. */
+    if( ( pSocketModuleData->callbackRefs == 0U ) && ( pSocketModuleData->removePending == true ) )
+    {
+        ( void ) _Cellular_RemoveSocketData( pSocketModuleData->pRemoveContext, pSocketModuleData->removeHandle );
+        pSocketModuleData->generation++;
+        pSocketModuleData->removePending = false;
+        pSocketModuleData->pRemoveContext = NULL;
+        pSocketModuleData->removeHandle = NULL;
+    }
+
+    ( void ) xSemaphoreGive( pModuleContext->socketLock );
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t _Cellular_SocketRemove( CellularContext_t * pContext,
+                                        cellularModuleContext_t * pModuleContext,
+                                        CellularSocketHandle_t socketHandle )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularSocketModuleData_t * pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+
+    ( void ) xSemaphoreTake( pModuleContext->socketLock, portMAX_DELAY );
+
+    if( pSocketModuleData->callbackRefs == 0U )
+    {
+        cellularStatus = _Cellular_RemoveSocketData( pContext, socketHandle );
+        pSocketModuleData->generation++;
+    }
+    else
+    {
+        /* A callback still uses the handle. No new callback gets it from now on. */
+        pSocketModuleData->removePending = true;
+        pSocketModuleData->pRemoveContext = pContext;
+        pSocketModuleData->removeHandle = socketHandle;
+    }
+
+    ( void ) xSemaphoreGive( pModuleContext->socketLock );
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void runSocketCallback( const cellularCallbackEvent_t * pEvent )
+{
+    cellularModuleContext_t * pModuleContext = &cellularSim70x0Context;
+    CellularSocketContext_t * pSocketData = pEvent->pSocketData;
+
+    /* A deferred callback may run after the socket was closed, or closed and reopened.
+     * The pin keeps the handle from being removed while the callback runs. */
+    if( _Cellular_SocketPin( pModuleContext, pEvent->socketId, pEvent->generation ) == false )
+    {
+        LogDebug( ( "runSocketCallback: socket %u closed, callback %d dropped",
+                    pEvent->socketId, pEvent->callbackType ) );
+        pModuleContext->callbackStats.stale++;
+    }
+    else
+    {
+        switch( pEvent->callbackType )
+        {
+            case CALLBACK_SOCKET_OPEN:
+
+                if( pSocketData->openCallback != NULL )
+                {
+                    pSocketData->openCallback( pEvent->urcEvent, pSocketData, pSocketData->pOpenCallbackContext );
+                }
+                else
+                {
+                    LogError( ( "runSocketCallback: Socket open callback for conn %u is not set!!", pEvent->socketId ) );
+                }
+
+                break;
+
+            case CALLBACK_SOCKET_CLOSED:
+
+                if( pSocketData->closedCallback != NULL )
+                {
+                    pSocketData->closedCallback( pSocketData, pSocketData->pClosedCallbackContext );
+                }
+                else
+                {
+                    LogInfo( ( "runSocketCallback: Socket close callback not set!!" ) );
+                }
+
+                break;
+
+            case CALLBACK_SOCKET_DATA_READY:
+
+                if( pSocketData->dataReadyCallback != NULL )
+                {
+                    pSocketData->dataReadyCallback( pSocketData, pSocketData->pDataReadyCallbackContext );
+                }
+                else
+                {
+                    LogError( ( "runSocketCallback: Data ready callback not set!!" ) );
+                }
+
+                break;
+
+            default:
+                break;
+        }
+
+        _Cellular_SocketUnpin( pModuleContext, pEvent->socketId );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SocketCallback( const CellularContext_t * pContext,
+                               cellularCallbackType_t callbackType,
+                               CellularSocketContext_t * pSocketData,
+                               CellularUrcEvent_t urcEvent )
+{
+    cellularModuleContext_t * pModuleContext = &cellularSim70x0Context;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    cellularCallbackStats_t * pStats = &pModuleContext->callbackStats;
+    cellularCallbackEvent_t event = { callbackType, pContext, 0, pSocketData, 0, urcEvent };
+    UBaseType_t queueCount = 0;
+    bool runInline = false;
+
+    if( ( pSocketData != NULL ) && ( pSocketData->socketId < CELLULAR_NUM_SOCKET_MAX ) )
+    {
+        event.socketId = pSocketData->socketId;
+        pSocketModuleData = &pModuleContext->socketData[ event.socketId ];
+
+        /* The handle is only removed with socketLock held, so generation belongs to pSocketData.
+         * stopCallbackTask also takes it before the queue goes away. */
+        ( void ) xSemaphoreTake( pModuleContext->socketLock, portMAX_DELAY );
+
+        event.generation = pSocketModuleData->generation;
+
+        if( _Cellular_GetSocketData( pContext, event.socketId ) != pSocketData )
+        {
+            LogDebug( ( "_Cellular_SocketCallback: socket %u closed, callback %d dropped",
+                        event.socketId, callbackType ) );
+            pStats->stale++;
+        }
+        else if( pModuleContext->callbackQueue == NULL )
+        {
+            runInline = true;
+        }
+        else if( ( CELLULAR_SIM70X0_CALLBACK_COALESCE_DATA_READY != 0 ) &&
+                 ( callbackType == CALLBACK_SOCKET_DATA_READY ) &&
+                 ( pSocketModuleData->dataReadyQueued == true ) )
+        {
+            /* The waiting callback tells the application about this data too. */
+            pStats->coalesced++;
+        }
+        else
+        {
+            if( callbackType == CALLBACK_SOCKET_DATA_READY )
+            {
+                pSocketModuleData->dataReadyQueued = true;
+            }
+
+            /* Never block the URC context. */
+            if( xQueueSend( pModuleContext->callbackQueue, &event, ( TickType_t ) 0 ) == pdPASS )
+            {
+                pStats->queued++;
+                queueCount = uxQueueMessagesWaiting( pModuleContext->callbackQueue );
+                pStats->maxQueued = ( ( uint32_t ) queueCount > pStats->maxQueued ) ?
+                                    ( uint32_t ) queueCount : pStats->maxQueued;
+            }
+            else
+            {
+                /* Late is better than lost for open and closed events. */
+                LogWarn( ( "_Cellular_SocketCallback: callback queue full, callback %d runs inline", callbackType ) );
+                pStats->overflows++;
+
+                if( callbackType == CALLBACK_SOCKET_DATA_READY )
+                {
+                    pSocketModuleData->dataReadyQueued = false;
+                }
+
+                runInline = true;
+            }
+        }
+
+        ( void ) xSemaphoreGive( pModuleContext->socketLock );
+
+        if( runInline == true )
+        {
+            runSocketCallback( &event );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_SIM70X0_DEFER_CALLBACKS != 0 )
+
+    static void moduleCallbackThread( void * pArgument )
+    {
+        cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pArgument;
+        /* stopCallbackTask clears callbackQueue before the exit event is queued. */
+        QueueHandle_t callbackQueue = pModuleContext->callbackQueue;
+        cellularCallbackEvent_t event = { CALLBACK_EXIT, NULL, 0, NULL, 0, CELLULAR_URC_SOCKET_OPENED };
+        bool exitTask = false;
+
+        while( exitTask == false )
+        {
+            if( xQueueReceive( callbackQueue, &event, portMAX_DELAY ) == pdTRUE )
+            {
+                if( event.callbackType == CALLBACK_EXIT )
+                {
+                    exitTask = true;
+                }
+                else
+                {
+                    /* Clear first. Data indicated while the callback runs queues another one. */
+                    if( event.callbackType == CALLBACK_SOCKET_DATA_READY )
+                    {
+                        pModuleContext->socketData[ event.socketId ].dataReadyQueued = false;
+                    }
+
+                    runSocketCallback( &event );
+                    pModuleContext->callbackStats.dispatched++;
+                }
+            }
+        }
+
+        LogDebug( ( "moduleCallbackThread: exit" ) );
+        ( void ) xEventGroupSetBits( pModuleContext->pdnEvent, EVENT_BIT_CALLBACK_EXITED );
+    }
+
+#endif /* if ( CELLULAR_SIM70X0_DEFER_CALLBACKS != 0 ) */
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t startCallbackTask( cellularModuleContext_t * pModuleContext )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    #if ( CELLULAR_SIM70X0_DEFER_CALLBACKS != 0 )
+        pModuleContext->callbackQueue = xQueueCreate( CELLULAR_SIM70X0_CALLBACK_QUEUE_LENGTH,
+                                                      sizeof( cellularCallbackEvent_t ) );
+
+        if( pModuleContext->callbackQueue == NULL )
+        {
+            cellularStatus = CELLULAR_NO_MEMORY;
+        }
+        else if( Platform_CreateDetachedThread( moduleCallbackThread, pModuleContext,
+                                                CELLULAR_SIM70X0_CALLBACK_TASK_PRIORITY,
+                                                CELLULAR_SIM70X0_CALLBACK_TASK_STACK_SIZE ) == false )
+        {
+            vQueueDelete( pModuleContext->callbackQueue );
+            pModuleContext->callbackQueue = NULL;
+            cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+        }
+        else
+        {
+            /* Callbacks are deferred from now on. */
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void stopCallbackTask( cellularModuleContext_t * pModuleContext )
+{
+    const cellularCallbackEvent_t exitEvent = { CALLBACK_EXIT, NULL, 0, NULL, 0, CELLULAR_URC_SOCKET_OPENED };
+    QueueHandle_t callbackQueue = NULL;
+
+    /* _Cellular_SocketCallback posts with socketLock held. No post follows this. */
+    ( void ) xSemaphoreTake( pModuleContext->socketLock, portMAX_DELAY );
+    callbackQueue = pModuleContext->callbackQueue;
+    pModuleContext->callbackQueue = NULL;
+    ( void ) xSemaphoreGive( pModuleContext->socketLock );
+
+    if( callbackQueue != NULL )
+    {
+        /* Callbacks from now on run in the URC context. */
+
+        /* Waiting callbacks run before the exit event. Like the worker, the task
+         * may be in an application callback and is waited for without a limit. */
+        ( void ) xQueueSend( callbackQueue, &exitEvent, portMAX_DELAY );
+        ( void ) xEventGroupWaitBits( pModuleContext->pdnEvent, EVENT_BIT_CALLBACK_EXITED,
+                                      pdTRUE, pdFALSE, portMAX_DELAY );
+
+        vQueueDelete( callbackQueue );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t createSocketModuleData( cellularModuleContext_t * pModuleContext )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t socketId = 0;
+
+    for( socketId = 0; socketId < CELLULAR_NUM_SOCKET_MAX; socketId++ )
+    {
+        pModuleContext->socketData[ socketId ].rxLock = xSemaphoreCreateMutex();
+        pModuleContext->socketData[ socketId ].txLock = xSemaphoreCreateMutex();
+
+        if( ( pModuleContext->socketData[ socketId ].rxLock == NULL ) ||
+            ( pModuleContext->socketData[ socketId ].txLock == NULL ) )
+        {
+            cellularStatus = CELLULAR_NO_MEMORY;
+            break;
+        }
+    }
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        destroySocketModuleData( pModuleContext );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void destroySocketModuleData( cellularModuleContext_t * pModuleContext )
+{
+    uint32_t socketId = 0;
+
+    for( socketId = 0; socketId < CELLULAR_NUM_SOCKET_MAX; socketId++ )
+    {
+        _Cellular_SocketModuleDataReset( pModuleContext, socketId );
+
+        if( pModuleContext->socketData[ socketId ].rxLock != NULL )
+        {
+            vSemaphoreDelete( pModuleContext->socketData[ socketId ].rxLock );
+            pModuleContext->socketData[ socketId ].rxLock = NULL;
+        }
+
+        if( pModuleContext->socketData[ socketId ].txLock != NULL )
+        {
+            vSemaphoreDelete( pModuleContext->socketData[ socketId ].txLock );
+            pModuleContext->socketData[ socketId ].txLock = NULL;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 /* FreeRTOS Cellular Common Library porting interface. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
 CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
@@ -134,18 +830,98 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
         }
         else
         {
-            /* Create the queue for DNS. */
-            cellularSim70x0Context.pktDnsQueue = xQueueCreate( 1, sizeof( cellularDnsQueryResult_t ) );
+            /* Create the event group for DNS query completion. */
+            cellularSim70x0Context.dnsEvent = xEventGroupCreate();
 
-            if(cellularSim70x0Context.pktDnsQueue == NULL )
+            if( cellularSim70x0Context.dnsEvent == NULL )
             {
                 PlatformMutex_Destroy( &cellularSim70x0Context.dnsQueryMutex );
                 cellularStatus = CELLULAR_NO_MEMORY;
             }
             else
             {
-                *ppModuleContext = ( void * )&cellularSim70x0Context;
                 cellularSim70x0Context.pdnEvent = xEventGroupCreate();
+                cellularSim70x0Context.rxDataEvent = xEventGroupCreate();
+                cellularSim70x0Context.workerQueue = xQueueCreate( CELLULAR_SIM70X0_WORKER_QUEUE_LENGTH,
+                                                                   sizeof( cellularWorkerJob_t ) );
+                cellularSim70x0Context.dnsCacheLock = xSemaphoreCreateMutex();
+                cellularSim70x0Context.pdnLock = xSemaphoreCreateMutex();
+                cellularSim70x0Context.socketLock = xSemaphoreCreateMutex();
+
+                if( ( cellularSim70x0Context.pdnEvent == NULL ) || ( cellularSim70x0Context.rxDataEvent == NULL ) ||
+                    ( cellularSim70x0Context.workerQueue == NULL ) || ( cellularSim70x0Context.dnsCacheLock == NULL ) ||
+                    ( cellularSim70x0Context.pdnLock == NULL ) || ( cellularSim70x0Context.socketLock == NULL ) )
+                {
+                    cellularStatus = CELLULAR_NO_MEMORY;
+                }
+                else
+                {
+                    cellularStatus = createSocketModuleData( &cellularSim70x0Context );
+                }
+
+                if( cellularStatus == CELLULAR_SUCCESS )
+                {
+                    cellularStatus = startCallbackTask( &cellularSim70x0Context );
+
+                    if( cellularStatus != CELLULAR_SUCCESS )
+                    {
+                        destroySocketModuleData( &cellularSim70x0Context );
+                    }
+                }
+
+                if( cellularStatus == CELLULAR_SUCCESS )
+                {
+                    status = Platform_CreateDetachedThread( moduleWorkerThread, &cellularSim70x0Context,
+                                                            PLATFORM_THREAD_DEFAULT_PRIORITY,
+                                                            PLATFORM_THREAD_DEFAULT_STACK_SIZE );
+
+                    if( status == false )
+                    {
+                        stopCallbackTask( &cellularSim70x0Context );
+                        destroySocketModuleData( &cellularSim70x0Context );
+                        cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+                    }
+                }
+
+                if( cellularStatus == CELLULAR_SUCCESS )
+                {
+                    *ppModuleContext = ( void * )&cellularSim70x0Context;
+                }
+                else
+                {
+                    if( cellularSim70x0Context.socketLock != NULL )
+                    {
+                        vSemaphoreDelete( cellularSim70x0Context.socketLock );
+                    }
+
+                    if( cellularSim70x0Context.pdnLock != NULL )
+                    {
+                        vSemaphoreDelete( cellularSim70x0Context.pdnLock );
+                    }
+
+                    if( cellularSim70x0Context.dnsCacheLock != NULL )
+                    {
+                        vSemaphoreDelete( cellularSim70x0Context.dnsCacheLock );
+                    }
+
+                    if( cellularSim70x0Context.workerQueue != NULL )
+                    {
+                        vQueueDelete( cellularSim70x0Context.workerQueue );
+                    }
+
+                    if( cellularSim70x0Context.rxDataEvent != NULL )
+                    {
+                        vEventGroupDelete( cellularSim70x0Context.rxDataEvent );
+                    }
+
+                    if( cellularSim70x0Context.pdnEvent != NULL )
+                    {
+                        vEventGroupDelete( cellularSim70x0Context.pdnEvent );
+                    }
+
+                    vEventGroupDelete( cellularSim70x0Context.dnsEvent );
+                    PlatformMutex_Destroy( &cellularSim70x0Context.dnsQueryMutex );
+                }
             }
         }
     }
@@ -167,8 +943,26 @@ CellularError_t Cellular_ModuleCleanUp( const CellularContext_t * pContext )
     }
     else
     {
-        /* Delete DNS queue. */
-        vQueueDelete(cellularSim70x0Context.pktDnsQueue );
+        const cellularWorkerJob_t exitJob = { WORKER_JOB_EXIT, NULL, 0, NULL };
+
+        /* Stop the worker before the objects it uses are deleted. A job may run
+         * as long as a socket send timeout or an application callback, so there
+         * is no time limit. Deleting the objects under a running worker is worse. */
+        ( void ) xQueueSend( cellularSim70x0Context.workerQueue, &exitJob, portMAX_DELAY );
+        ( void ) xEventGroupWaitBits( cellularSim70x0Context.pdnEvent, EVENT_BIT_WORKER_EXITED,
+                                      pdTRUE, pdFALSE, portMAX_DELAY );
+
+        vQueueDelete( cellularSim70x0Context.workerQueue );
+        stopCallbackTask( &cellularSim70x0Context );
+        destroySocketModuleData( &cellularSim70x0Context );
+        vEventGroupDelete( cellularSim70x0Context.rxDataEvent );
+        vEventGroupDelete( cellularSim70x0Context.pdnEvent );
+        vSemaphoreDelete( cellularSim70x0Context.pdnLock );
+        vSemaphoreDelete( cellularSim70x0Context.socketLock );
+
+        /* Delete DNS event group. */
+        vEventGroupDelete( cellularSim70x0Context.dnsEvent );
+        vSemaphoreDelete( cellularSim70x0Context.dnsCacheLock );
 
         /* Delete the mutex for DNS. */
         PlatformMutex_Destroy( &cellularSim70x0Context.dnsQueryMutex );
@@ -261,6 +1055,10 @@ static CellularPktStatus_t set_CID_range_cb(CellularContext_t* pContext,
             strncpy(ns, pB2, pE2 - pB2);
             nCID_Max = (uint8_t)atoi(ns);
 
+            /* pdnContexts has room up to CELLULAR_CID_MAX. */
+            if (nCID_Max > CELLULAR_CID_MAX)
+                nCID_Max = CELLULAR_CID_MAX;
+
             CellularLogInfo("CAxxx CID range: %d - %d", nCID_Min, nCID_Max);
             return CELLULAR_AT_SUCCESS;
         }
@@ -270,6 +1068,234 @@ static CellularPktStatus_t set_CID_range_cb(CellularContext_t* pContext,
 }
 
 
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_SIM70X0_STARTUP_DIFF != 0 )
+
+/* Clear differs of each setting whose read response matches its value. */
+    static CellularPktStatus_t startupReadCb( CellularContext_t * pContext,
+                                              const CellularATCommandResponse_t * pAtResp,
+                                              void * pData,
+                                              uint16_t dataLen )
+    {
+        startupSetting_t * pSettings = ( startupSetting_t * ) pData;
+        const CellularATCommandLine_t * pItem = NULL;
+        char line[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+        char value[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+        const char * pIn = NULL;
+        char * pOut = NULL;
+        size_t queryLen = 0;
+        uint16_t i = 0;
+
+        UNREFERENCED_PARAMETER( pContext );
+
+        for( pItem = ( pAtResp != NULL ) ? pAtResp->pItm : NULL; pItem != NULL; pItem = pItem->pNext )
+        {
+            /* Compare without quotes and spaces. */
+            pOut = line;
+
+            for( pIn = pItem->pLine; ( *pIn != '\0' ) && ( pOut < &line[ sizeof( line ) - 1U ] ); pIn++ )
+            {
+                if( ( *pIn != '"' ) && ( *pIn != ' ' ) )
+                {
+                    *pOut = *pIn;
+                    pOut++;
+                }
+            }
+
+            *pOut = '\0';
+
+            for( i = 0; i < dataLen; i++ )
+            {
+                queryLen = strlen( pSettings[ i ].query );
+
+                if( ( queryLen == 0U ) || ( strncmp( line, pSettings[ i ].query, queryLen ) != 0 ) ||
+                    ( line[ queryLen ] != ':' ) )
+                {
+                    continue;
+                }
+
+                pOut = value;
+
+                for( pIn = pSettings[ i ].pValue; ( *pIn != '\0' ) && ( pOut < &value[ sizeof( value ) - 1U ] ); pIn++ )
+                {
+                    if( *pIn != '"' )
+                    {
+                        *pOut = *pIn;
+                        pOut++;
+                    }
+                }
+
+                *pOut = '\0';
+
+                if( strcmp( &line[ queryLen + 1U ], value ) == 0 )
+                {
+                    pSettings[ i ].differs = false;
+                }
+            }
+        }
+
+        return CELLULAR_PKT_STATUS_OK;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Read every setting of pCmds with one query line and only send the ones
+ * which differ. The last command is AT+CFUN=1, sent on its own after the
+ * others were saved with AT&W. cmdMs is the measured round trip of one
+ * command, the time each skipped setting saves. */
+    static CellularError_t startupDiffSend( CellularContext_t * pContext,
+                                           cellularAtBatchCmd_t * pCmds,
+                                           uint32_t numCmds,
+                                           uint32_t cmdMs )
+    {
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        cellularStartupStats_t * pStats = &cellularSim70x0Context.startupStats;
+        startupSetting_t settings[ CELLULAR_SIM70X0_STARTUP_CMD_MAX ];
+        cellularAtBatchCmd_t sendCmds[ CELLULAR_SIM70X0_STARTUP_CMD_MAX ];
+        char queryLine[ CELLULAR_AT_CMD_MAX_SIZE ] = "AT";
+        const char * pEqual = NULL;
+        const TickType_t startTick = xTaskGetTickCount();
+        TickType_t readTick = 0;
+        uint32_t numSend = 0;
+        uint32_t i = 0;
+        uint32_t j = 0;
+        size_t queryLen = 0;
+        bool queried = false;
+        bool saveProfile = false;
+        CellularAtReq_t atReqRead =
+        {
+            queryLine,
+            CELLULAR_AT_MULTI_WO_PREFIX,
+            NULL,
+            startupReadCb,
+            settings,
+            0
+        };
+        CellularAtReq_t atReqNoResult =
+        {
+            NULL,
+            CELLULAR_AT_NO_RESULT,
+            NULL,
+            NULL,
+            NULL,
+            0
+        };
+
+        ( void ) memset( settings, 0, sizeof( settings ) );
+        ( void ) memset( pStats, 0, sizeof( cellularStartupStats_t ) );
+        pStats->diffMode = true;
+        pStats->cmdMs = cmdMs;
+        atReqRead.dataLen = ( uint16_t ) numCmds;
+
+        /* Extended settings are read back, "AT+IFC=2,2" with "+IFC?". */
+        for( i = 0; i < numCmds; i++ )
+        {
+            settings[ i ].pAtCmd = pCmds[ i ].pAtCmd;
+            settings[ i ].differs = true;
+            pEqual = strchr( pCmds[ i ].pAtCmd, '=' );
+
+            if( ( strncmp( pCmds[ i ].pAtCmd, "AT+", 3U ) == 0 ) && ( pEqual != NULL ) &&
+                ( ( size_t ) ( pEqual - &pCmds[ i ].pAtCmd[ 2 ] ) < sizeof( settings[ i ].query ) ) )
+            {
+                queryLen = ( size_t ) ( pEqual - &pCmds[ i ].pAtCmd[ 2 ] );
+                ( void ) memcpy( settings[ i ].query, &pCmds[ i ].pAtCmd[ 2 ], queryLen );
+                settings[ i ].pValue = &pEqual[ 1 ];
+
+                /* Query each command once, +CBANDCFG? lists every band setting. */
+                queried = false;
+
+                for( j = 0; j < i; j++ )
+                {
+                    queried = ( strcmp( settings[ j ].query, settings[ i ].query ) == 0 ) ? true : queried;
+                }
+
+                if( ( queried == false ) && ( ( strlen( queryLine ) + queryLen + 2U ) < sizeof( queryLine ) ) )
+                {
+                    ( void ) strcat( queryLine, ( queryLine[ 2 ] == '\0' ) ? "" : ";" );
+                    ( void ) strcat( queryLine, settings[ i ].query );
+                    ( void ) strcat( queryLine, "?" );
+                }
+            }
+        }
+
+        if( _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqRead, ENBABLE_MODULE_UE_RETRY_TIMEOUT ) !=
+            CELLULAR_PKT_STATUS_OK )
+        {
+            /* Send everything, as without CELLULAR_SIM70X0_STARTUP_DIFF. */
+            LogWarn( ( "startupDiffSend: %s failed", queryLine ) );
+
+            for( i = 0; i < numCmds; i++ )
+            {
+                settings[ i ].differs = true;
+            }
+        }
+
+        readTick = xTaskGetTickCount();
+        pStats->readMs = ( uint32_t ) ( readTick - startTick ) * ( uint32_t ) portTICK_PERIOD_MS;
+
+        for( i = 0; i < numCmds; i++ )
+        {
+            /* Sending an earlier setting of the same command may override this one. */
+            for( j = 0; ( j < i ) && ( settings[ i ].differs == false ); j++ )
+            {
+                if( ( settings[ j ].differs == true ) && ( settings[ i ].query[ 0 ] != '\0' ) &&
+                    ( strcmp( settings[ j ].query, settings[ i ].query ) == 0 ) )
+                {
+                    settings[ i ].differs = true;
+                }
+            }
+
+            if( settings[ i ].differs == false )
+            {
+                LogInfo( ( "startupDiffSend: skip %s", settings[ i ].pAtCmd ) );
+                pStats->pSkippedCmds[ pStats->skippedCount ] = settings[ i ].pAtCmd;
+                pStats->skippedCount++;
+            }
+            else if( i < ( numCmds - 1U ) )
+            {
+                sendCmds[ numSend ] = pCmds[ i ];
+                numSend++;
+                saveProfile = ( settings[ i ].query[ 0 ] != '\0' ) ? true : saveProfile;
+            }
+            else
+            {
+                /* AT+CFUN=1, sent last. */
+            }
+        }
+
+        if( numSend > 0U )
+        {
+            cellularStatus = _Cellular_AtBatchSend( pContext, sendCmds, numSend,
+                                                    ENBABLE_MODULE_UE_RETRY_TIMEOUT, ENBABLE_MODULE_UE_RETRY_COUNT );
+        }
+
+        if( ( cellularStatus == CELLULAR_SUCCESS ) && ( saveProfile == true ) )
+        {
+            /* The next boot finds these settings in place. */
+            atReqNoResult.pAtCmd = "AT&W";
+            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqNoResult );
+            pStats->profileSaved = ( cellularStatus == CELLULAR_SUCCESS );
+        }
+
+        if( ( cellularStatus == CELLULAR_SUCCESS ) && ( numCmds > 0U ) && ( settings[ numCmds - 1U ].differs == true ) )
+        {
+            atReqNoResult.pAtCmd = pCmds[ numCmds - 1U ].pAtCmd;
+            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqNoResult );
+            numSend++;
+        }
+
+        pStats->sentCount = ( uint8_t ) numSend;
+        pStats->elapsedMs = ( uint32_t ) ( xTaskGetTickCount() - startTick ) * ( uint32_t ) portTICK_PERIOD_MS;
+        pStats->savedMs = ( uint32_t ) pStats->skippedCount * cmdMs;
+        LogInfo( ( "startupDiffSend: %u sent, %u skipped, %u ms saved",
+                   pStats->sentCount, pStats->skippedCount, pStats->savedMs ) );
+
+        return cellularStatus;
+    }
+
+#endif /* if ( CELLULAR_SIM70X0_STARTUP_DIFF != 0 ) */
+
 /*-----------------------------------------------------------*/
 
 /* FreeRTOS Cellular Common Library porting interface. */
@@ -296,54 +1322,30 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
         0
     };
 
+    cellularAtBatchCmd_t setupCmds[ STARTUP_CMD_COUNT ] =
+    {
+        { "AT&D0", CELLULAR_SUCCESS },                                  /* Disable DTR function. */
+        { "AT+IFC=2,2", CELLULAR_SUCCESS },                             /* Enable RTS/CTS hardware flow control. */
+        { "AT+CLTS=0", CELLULAR_SUCCESS },                              /* No *PSUTTZ report. */
+        { "AT+CBANDCFG=\"CAT-M\",1,3,8,18,19,26", CELLULAR_SUCCESS },   /* Cat-M1 bands, for Japan. */
+        { "AT+CBANDCFG=\"NB-IOT\",1,3,8,18,19,26", CELLULAR_SUCCESS },  /* NB-IOT bands, for Japan. */
+        { "AT+CNMP=38", CELLULAR_SUCCESS },                             /* Only LTE, no GSM support. */
+        { NULL, CELLULAR_SUCCESS },                                     /* RAT, set below. */
+        { "AT+CFUN=1", CELLULAR_SUCCESS }                               /* Last, once configured. */
+    };
+    uint32_t numSetupCmds = STARTUP_CMD_COUNT;
+    TickType_t cmdTick = 0;
+    uint32_t cmdMs = 0;
+
     if( pContext != NULL )
     {
-        /* Disable echo. */
+        /* Disable echo. On its own so the echo of the other commands is off. */
         atReqGetWithResult.pAtCmd = "ATE0";
+        cmdTick = xTaskGetTickCount();
         cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetWithResult );
 
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
-            /* Disable DTR function. */
-            atReqGetNoResult.pAtCmd = "AT&D0";
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
-
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
-            /* Enable RTS/CTS hardware flow control. */
-            atReqGetNoResult.pAtCmd = "AT+IFC=2,2";
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
-
-        if (cellularStatus == CELLULAR_SUCCESS)
-        {
-            /* Disable DTR function. */
-            atReqGetNoResult.pAtCmd = "AT+CLTS=0";  //no *PSUTTZ report
-            cellularStatus = sendAtCommandWithRetryTimeout(pContext, &atReqGetNoResult);
-        }
-
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
-            /* Configure Band configuration to all Cat-M1 bands. */
-            atReqGetNoResult.pAtCmd = "AT+CBANDCFG=\"CAT-M\",1,3,8,18,19,26";   /*for Japan     */
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
-
-        if (cellularStatus == CELLULAR_SUCCESS)
-        {
-            /* Configure Band configuration to all NB-IOT bands. */
-            atReqGetNoResult.pAtCmd = "AT+CBANDCFG=\"NB-IOT\",1,3,8,18,19,26";   /*for Japan    */
-            cellularStatus = sendAtCommandWithRetryTimeout(pContext, &atReqGetNoResult);
-        }
-
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
-            /* Configure Network mode select to Automatic. */
-//          atReqGetNoResult.pAtCmd = "AT+CNMP=2";
-            atReqGetNoResult.pAtCmd = "AT+CNMP=38";     /*Only LTE, no GSM support  */
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
+        /* Round trip of a plain setting, see Cellular_GetStartupStats. */
+        cmdMs = ( uint32_t ) ( xTaskGetTickCount() - cmdTick ) * ( uint32_t ) portTICK_PERIOD_MS;
 
         if( cellularStatus == CELLULAR_SUCCESS )
         {
@@ -351,26 +1353,38 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
             switch (CELLULAR_CONFIG_DEFAULT_RAT)
             {
             case CELLULAR_RAT_CATM1:
-                atReqGetNoResult.pAtCmd = "AT+CMNB=1";
+                setupCmds[ 6 ].pAtCmd = "AT+CMNB=1";
                 break;
             case CELLULAR_RAT_NBIOT:
-                atReqGetNoResult.pAtCmd = "AT+CMNB=2";
+                setupCmds[ 6 ].pAtCmd = "AT+CMNB=2";
                 break;
             case CELLULAR_RAT_GSM:
-                atReqGetNoResult.pAtCmd = "AT+CNMP=13";
+                /* Replaces AT+CNMP=38. Sending both would make the startup diff
+                 * find AT+CNMP=38 changed and save the profile on every boot. */
+                setupCmds[ 5 ].pAtCmd = "AT+CNMP=13";
+                setupCmds[ 6 ] = setupCmds[ 7 ];
+                numSetupCmds--;
                 break;
             default:
                 /* Configure RAT Searching Sequence to automatic. */
-                atReqGetNoResult.pAtCmd = "AT+CMNB=3";
+                setupCmds[ 6 ].pAtCmd = "AT+CMNB=3";
                 break;
             }
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
 
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
-            atReqGetNoResult.pAtCmd = "AT+CFUN=1";
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
+            #if ( CELLULAR_SIM70X0_STARTUP_DIFF != 0 )
+                cellularStatus = startupDiffSend( pContext, setupCmds, numSetupCmds, cmdMs );
+            #else
+                ( void ) cmdMs;
+                cellularStatus = _Cellular_AtBatchSend( pContext, setupCmds, numSetupCmds - 1U,
+                                                        ENBABLE_MODULE_UE_RETRY_TIMEOUT, ENBABLE_MODULE_UE_RETRY_COUNT );
+
+                if( cellularStatus == CELLULAR_SUCCESS )
+                {
+                    /* Sent last and on its own, the radio is only turned on once configured. */
+                    atReqGetNoResult.pAtCmd = setupCmds[ numSetupCmds - 1U ].pAtCmd;
+                    cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
+                }
+            #endif
         }
 
         atReqGetWithResult.pAtCmd = "AT+CACID=?";
@@ -396,30 +1410,18 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 CellularError_t Cellular_ModuleEnableUrc( CellularContext_t * pContext )
 {
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularAtReq_t atReqGetNoResult =
+    cellularAtBatchCmd_t urcCmds[] =
     {
-        NULL,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0
+        { "AT+COPS=3,2", CELLULAR_SUCCESS },
+        { "AT+CREG=2", CELLULAR_SUCCESS },
+        { "AT+CGREG=2", CELLULAR_SUCCESS },
+        { "AT+CEREG=2", CELLULAR_SUCCESS },
+        { "AT+CTZR=1", CELLULAR_SUCCESS }
     };
 
-    atReqGetNoResult.pAtCmd = "AT+COPS=3,2";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
-
-    atReqGetNoResult.pAtCmd = "AT+CREG=2";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
-
-    atReqGetNoResult.pAtCmd = "AT+CGREG=2";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
-
-    atReqGetNoResult.pAtCmd = "AT+CEREG=2";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
-
-    atReqGetNoResult.pAtCmd = "AT+CTZR=1";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
+    /* Failures are ignored, each command is tried once. */
+    ( void ) _Cellular_AtBatchSend( pContext, urcCmds, sizeof( urcCmds ) / sizeof( urcCmds[ 0 ] ),
+                                    ENBABLE_MODULE_UE_RETRY_TIMEOUT, 1U );
 
     return cellularStatus;
 }
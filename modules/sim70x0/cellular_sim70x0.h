@@ -63,33 +63,450 @@ typedef enum cellularDnsQueryResult
     CELLULAR_DNS_QUERY_UNKNOWN
 } cellularDnsQueryResult_t;
 
+/* Addresses kept per hostname. +CDNSGIP reports a primary and a secondary address. */
+#ifndef CELLULAR_SIM70X0_DNS_MAX_ADDRESSES
+    #define CELLULAR_SIM70X0_DNS_MAX_ADDRESSES    ( 2U )
+#endif
+
+/**
+ * @brief Addresses of a hostname in the order +CDNSGIP reports them, see
+ * Cellular_GetHostByNameAll.
+ */
+typedef struct cellularDnsResult
+{
+    uint8_t addressCount;
+    char addresses[ CELLULAR_SIM70X0_DNS_MAX_ADDRESSES ][ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ];
+} cellularDnsResult_t;
+
+/* Number of hostnames kept by the DNS cache of Cellular_GetHostByName. */
+#ifndef CELLULAR_SIM70X0_DNS_CACHE_SIZE
+    #define CELLULAR_SIM70X0_DNS_CACHE_SIZE    ( 8U )
+#endif
+
+/* Lifetime of a resolved address in the DNS cache, 0 disables the cache.
+ * AT+CDNSGIP doesn't report the record TTL. */
+#ifndef CELLULAR_SIM70X0_DNS_CACHE_TTL_MS
+    #define CELLULAR_SIM70X0_DNS_CACHE_TTL_MS    ( 300000U )
+#endif
+
+/* Lifetime of a failed lookup in the DNS cache, 0 disables negative caching. */
+#ifndef CELLULAR_SIM70X0_DNS_NEGATIVE_TTL_MS
+    #define CELLULAR_SIM70X0_DNS_NEGATIVE_TTL_MS    ( 10000U )
+#endif
+
+/* Longer hostnames are resolved but not cached, and can't be resolved
+ * with Cellular_GetHostByNameAsync. */
+#ifndef CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN
+    #define CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN    ( 64U )
+#endif
+
+typedef struct cellularDnsCacheEntry
+{
+    char hostName[ CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN + 1U ];  /* Empty if the entry is unused. */
+    cellularDnsResult_t dnsResult;  /* No address caches a failed lookup. */
+    uint8_t contextId;
+    TickType_t storedTick;          /* Start of the TTL. */
+    TickType_t lastUsedTick;        /* LRU eviction order. */
+} cellularDnsCacheEntry_t;
+
+/**
+ * @brief DNS cache statistics, see Cellular_GetDnsCacheStats.
+ */
+typedef struct cellularDnsCacheStats
+{
+    uint32_t hits;          /* Lookups answered with a cached address. */
+    uint32_t negativeHits;  /* Lookups answered with a cached failure. */
+    uint32_t misses;        /* Lookups sent to the modem. */
+    uint32_t evictions;     /* Live entries replaced because the cache was full. */
+} cellularDnsCacheStats_t;
+
+/* Time Cellular_SocketConnectAny gives one address to connect. */
+#ifndef CELLULAR_SIM70X0_CONNECT_ATTEMPT_TIMEOUT_MS
+    #define CELLULAR_SIM70X0_CONNECT_ATTEMPT_TIMEOUT_MS    ( 20000U )
+#endif
+
+/* AT+CDNSGIP timeout and retry count of Cellular_GetHostByName. */
+#ifndef CELLULAR_SIM70X0_DNS_TIMEOUT_MS
+    #define CELLULAR_SIM70X0_DNS_TIMEOUT_MS    ( 10000U )
+#endif
+
+#ifndef CELLULAR_SIM70X0_DNS_RETRY_COUNT
+    #define CELLULAR_SIM70X0_DNS_RETRY_COUNT    ( 0U )
+#endif
+
+/**
+ * @brief Result callback of Cellular_GetHostByNameAsync.
+ *
+ * status is CELLULAR_SUCCESS with the addresses in pDnsResult,
+ * CELLULAR_UNKNOWN if the name doesn't resolve or CELLULAR_TIMEOUT.
+ * pDnsResult is NULL unless status is CELLULAR_SUCCESS and is only valid
+ * during the call.
+ */
+typedef void ( * CellularDnsCallback_t )( uint32_t requestId,
+                                          const char * pcHostName,
+                                          CellularError_t status,
+                                          const cellularDnsResult_t * pDnsResult,
+                                          void * pUserData );
+
+/* Number of DNS queries, blocking and asynchronous, waiting for +CDNSGIP at the same time. */
+#ifndef CELLULAR_SIM70X0_DNS_MAX_QUERIES
+    #define CELLULAR_SIM70X0_DNS_MAX_QUERIES    ( 4U )
+#endif
+
+/* dnsEvent bit of a DNS query slot. */
+#define DNS_EVENT_BIT( queryIndex )    ( ( EventBits_t ) 1U << ( queryIndex ) )
+
+/**
+ * @brief In-flight AT+CDNSGIP query of one Cellular_GetHostByName call.
+ *
+ * Calls for the same host and context share the sequence of the query which
+ * is already in flight instead of sending another AT+CDNSGIP.
+ */
+typedef struct cellularDnsQuery
+{
+    const char * pcHostName;            /* NULL if the slot is free. */
+    cellularDnsResult_t dnsResult;      /* Written by the +CDNSGIP handler. */
+    uint8_t contextId;
+    uint32_t sequence;                  /* Send order of the AT+CDNSGIP the slot waits for. */
+    bool done;                          /* +CDNSGIP received or the command failed. */
+    cellularDnsQueryResult_t result;
+    TickType_t startTick;
+    uint32_t waitMs;                    /* Time to wait for +CDNSGIP from startTick. */
+
+    /* Cellular_GetHostByNameAsync only. */
+    CellularDnsCallback_t callback;     /* NULL for a blocking query. */
+    void * pUserData;
+    uint32_t requestId;
+    char hostName[ CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN + 1U ];  /* pcHostName points here. */
+} cellularDnsQuery_t;
+
+/* Depth of the module worker job queue. */
+#ifndef CELLULAR_SIM70X0_WORKER_QUEUE_LENGTH
+    #define CELLULAR_SIM70X0_WORKER_QUEUE_LENGTH    ( 8U )
+#endif
+
+/* Default time coalesced send data may wait before it is flushed. */
+#ifndef CELLULAR_SIM70X0_TX_COALESCE_TIMEOUT_MS
+    #define CELLULAR_SIM70X0_TX_COALESCE_TIMEOUT_MS    ( 50U )
+#endif
+
+/* Interval of AT+CAACK while a window limited send waits for acknowledges. */
+#ifndef CELLULAR_SIM70X0_TX_WINDOW_POLL_MS
+    #define CELLULAR_SIM70X0_TX_WINDOW_POLL_MS    ( 100U )
+#endif
+
+/* Run socket open, closed and data ready callbacks from a dispatch task
+ * instead of the URC context, so a slow callback doesn't stall parsing. */
+#ifndef CELLULAR_SIM70X0_DEFER_CALLBACKS
+    #define CELLULAR_SIM70X0_DEFER_CALLBACKS    ( 0 )
+#endif
+
+/* Read the settings of Cellular_ModuleEnableUE with one query line at
+ * startup and only send the ones the modem doesn't have, then save them
+ * with AT&W. See Cellular_GetStartupStats. */
+#ifndef CELLULAR_SIM70X0_STARTUP_DIFF
+    #define CELLULAR_SIM70X0_STARTUP_DIFF    ( 0 )
+#endif
+
+/* Number of settings sent by Cellular_ModuleEnableUE. */
+#define CELLULAR_SIM70X0_STARTUP_CMD_MAX    ( 8U )
+
+/* Depth of the deferred callback queue. A callback that doesn't fit runs in
+ * the URC context and is counted as an overflow. */
+#ifndef CELLULAR_SIM70X0_CALLBACK_QUEUE_LENGTH
+    #define CELLULAR_SIM70X0_CALLBACK_QUEUE_LENGTH    ( 8U )
+#endif
+
+#ifndef CELLULAR_SIM70X0_CALLBACK_TASK_PRIORITY
+    #define CELLULAR_SIM70X0_CALLBACK_TASK_PRIORITY    PLATFORM_THREAD_DEFAULT_PRIORITY
+#endif
+
+#ifndef CELLULAR_SIM70X0_CALLBACK_TASK_STACK_SIZE
+    #define CELLULAR_SIM70X0_CALLBACK_TASK_STACK_SIZE    PLATFORM_THREAD_DEFAULT_STACK_SIZE
+#endif
+
+/* Queue at most one data ready callback per socket until it has run. */
+#ifndef CELLULAR_SIM70X0_CALLBACK_COALESCE_DATA_READY
+    #define CELLULAR_SIM70X0_CALLBACK_COALESCE_DATA_READY    ( 1 )
+#endif
+
 typedef enum cellularEventBitEnum
 {
     EVENT_BIT_PDN_ACT = (1 << 0),
-    EVENT_BIT_RX_DATA = (1 << 1),
+    EVENT_BIT_WORKER_EXITED = (1 << 1),
+    EVENT_BIT_CALLBACK_EXITED = (1 << 2),
 }   cellularEventBit_t;
 
-typedef struct cellularModuleContext cellularModuleContext_t;
+/* Bit of pdnEvent for a CID. Set on +APP PDP for the CID. */
+#define PDN_EVENT_BIT( cid )    ( ( EventBits_t ) 1U << ( 8U + ( uint32_t ) ( cid ) ) )
+
+/**
+ * @brief Result callback of Cellular_ActivatePdnAsync.
+ *
+ * status is CELLULAR_SUCCESS if +APP PDP reported ACTIVE, CELLULAR_UNKNOWN
+ * if it reported DEACTIVE or CELLULAR_TIMEOUT if it didn't arrive within
+ * PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS. pIpAddress is the address of the
+ * context from AT+CNACT?, NULL if it couldn't be read, and is only valid
+ * during the call. latencyMs is the time from the start of the activation
+ * to the URC.
+ */
+typedef void ( * CellularPdnActivateCallback_t )( uint8_t contextId,
+                                                  CellularError_t status,
+                                                  const char * pIpAddress,
+                                                  uint32_t latencyMs,
+                                                  void * pUserData );
+
+/**
+ * @brief PDN state of a CID.
+ */
+typedef struct cellularPdnContext
+{
+    bool configured;                /* config was set with Cellular_SetPdnConfig. */
+    CellularPdnConfig_t config;     /* Copy used for AT+CNCFG on activation. */
+    bool active;                    /* Last known state. */
+
+    /* State cache of Cellular_GetPdnStatus, protected by pdnLock. Updated by
+     * +APP PDP, +CAURC: "pdpdeact", Cellular_DeactivatePdn and AT+CNACT?.
+     * Dropped on RDY and NORMAL POWER DOWN. */
+    bool stateKnown;
+    bool addressKnown;              /* False after +APP PDP ACTIVE until AT+CNACT? is read. */
+    char ipAddress[ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ];
+    TickType_t stateTick;           /* When the state was last updated. */
+
+    /* Cellular_ActivatePdnAsync request, protected by pdnLock. */
+    bool activating;                /* Waiting for +APP PDP. */
+    bool reported;                  /* +APP PDP arrived, the worker completes the request. */
+    TickType_t activateTick;        /* When Cellular_ActivatePdnAsync was called. */
+    TickType_t reportTick;          /* When +APP PDP arrived. */
+    CellularContext_t * pContext;
+    CellularPdnActivateCallback_t activateCallback;
+    void * pActivateUserData;
+} cellularPdnContext_t;
+
+/* Bit of rxDataEvent for a socket. Set on +CADATAIND, cleared on +CARECV: 0. */
+#define RX_DATA_EVENT_BIT( socketId )    ( ( EventBits_t ) 1U << ( socketId ) )
+
+/**
+ * @brief Module specific socket options for Cellular_SocketSetModuleOpt.
+ */
+typedef enum cellularSocketModuleOption
+{
+    CELLULAR_SOCKET_MODULE_OPT_RX_BUFFER_SIZE,      /* uint32_t. RX ring size in bytes, 0 disables the ring. */
+    CELLULAR_SOCKET_MODULE_OPT_RECV_NONBLOCKING,    /* bool. Cellular_SocketRecv returns 0 bytes at once if no data is indicated. */
+    CELLULAR_SOCKET_MODULE_OPT_RECV_DRAIN,          /* bool. Cellular_SocketRecv reads until the buffer is full or the modem is empty. */
+    CELLULAR_SOCKET_MODULE_OPT_TX_COALESCE_SIZE,    /* uint32_t. Send coalescing flush threshold in bytes, 0 disables coalescing. */
+    CELLULAR_SOCKET_MODULE_OPT_TX_COALESCE_TIMEOUT, /* uint32_t. Max time in ms coalesced data waits before it is flushed. */
+    CELLULAR_SOCKET_MODULE_OPT_SEND_ALL,            /* bool. Cellular_SocketSend splits large data into chunks and sends all of it. */
+    CELLULAR_SOCKET_MODULE_OPT_TX_WINDOW,           /* uint32_t. Max bytes sent but not acknowledged by the remote, 0 disables. */
+    CELLULAR_SOCKET_MODULE_OPT_SEND_NONBLOCKING,    /* bool. Cellular_SocketSend returns 0 bytes at once if the TX window is full. */
+} cellularSocketModuleOption_t;
+
+/**
+ * @brief AT+CASEND statistics of a socket, see Cellular_SocketGetSendStats.
+ */
+typedef struct cellularSocketSendStats
+{
+    uint32_t chunkCount;    /* Number of AT+CASEND completed. */
+    uint32_t bytesSent;     /* Bytes accepted by the modem. */
+    uint32_t lastChunkMs;   /* Time of the last AT+CASEND, from the command to the result. */
+    uint32_t minChunkMs;
+    uint32_t maxChunkMs;
+    uint32_t totalChunkMs;  /* Sum of all chunk times. Divide by chunkCount for the average. */
+} cellularSocketSendStats_t;
+
+/**
+ * @brief AT+CAACK result of a socket, see Cellular_SocketGetAckInfo.
+ */
+typedef struct cellularSocketAckInfo
+{
+    uint32_t totalSent;     /* Bytes sent on the connection. */
+    uint32_t unacked;       /* Bytes of totalSent not acknowledged by the remote yet. */
+} cellularSocketAckInfo_t;
+
+/**
+ * @brief +CADATAIND statistics of a socket, see Cellular_SocketGetRecvStats.
+ */
+typedef struct cellularSocketRecvStats
+{
+    uint32_t dataIndications;   /* +CADATAIND received. */
+    uint32_t dataIndCoalesced;  /* Indications not passed on because the socket wasn't drained yet. */
+} cellularSocketRecvStats_t;
+
+/**
+ * @brief A buffer segment of Cellular_SocketSendv and Cellular_SocketRecvv.
+ */
+typedef struct cellularSocketIoVec
+{
+    uint8_t * pBuffer;
+    uint32_t bufferLength;
+} cellularSocketIoVec_t;
+
+/**
+ * @brief Completion callback of Cellular_SocketSendAsync.
+ *
+ * Called from the module worker task. sentDataLength is the length taken by
+ * the module, which may be less than the requested length, 0 if the TX
+ * window is full. If the socket is closed before the request is sent,
+ * Cellular_SocketClose calls it with a NULL socketHandle and
+ * CELLULAR_SOCKET_NOT_CONNECTED.
+ */
+typedef void ( * CellularSocketSendCallback_t )( CellularSocketHandle_t socketHandle,
+                                                 CellularError_t sendStatus,
+                                                 uint32_t sentDataLength,
+                                                 void * pCallbackContext );
+
+/**
+ * @brief Module specific data of a socket, indexed by socket ID.
+ */
+typedef struct cellularSocketModuleData
+{
+    SemaphoreHandle_t rxLock;       /* Serializes AT+CARECV and ring access of the socket. */
+    uint8_t * pRxRing;              /* RX ring filled by the worker on +CADATAIND. NULL if disabled. */
+    uint32_t rxRingSize;
+    uint32_t rxRingHead;            /* Read index of the ring. */
+    uint32_t rxRingCount;           /* Number of bytes in the ring. */
+    volatile bool rxFetchQueued;    /* A fetch job for this socket is in the worker queue. */
+    bool rxModemData;               /* +CADATAIND seen, no +CARECV: 0 since. Protected by socketLock. */
+    bool recvNonBlocking;           /* CELLULAR_SOCKET_MODULE_OPT_RECV_NONBLOCKING. */
+    bool recvDrain;                 /* CELLULAR_SOCKET_MODULE_OPT_RECV_DRAIN. */
+    cellularSocketRecvStats_t recvStats;
+    SemaphoreHandle_t txLock;       /* Serializes AT+CASEND and coalescing buffer access of the socket. */
+    uint8_t * pTxBuf;               /* Send coalescing buffer. NULL if disabled. */
+    uint32_t txBufSize;             /* Flush threshold, size of pTxBuf. */
+    uint32_t txBufLen;              /* Number of bytes waiting in pTxBuf. */
+    uint32_t txFlushTimeoutMs;      /* CELLULAR_SOCKET_MODULE_OPT_TX_COALESCE_TIMEOUT. */
+    TickType_t txFirstTick;         /* When the oldest byte in pTxBuf was buffered. */
+    bool sendAll;                   /* CELLULAR_SOCKET_MODULE_OPT_SEND_ALL. */
+    cellularSocketSendStats_t sendStats;
+    uint32_t txWindow;              /* CELLULAR_SOCKET_MODULE_OPT_TX_WINDOW. */
+    bool sendNonBlocking;           /* CELLULAR_SOCKET_MODULE_OPT_SEND_NONBLOCKING. */
+    volatile bool dataReadyQueued;  /* A deferred data ready callback is waiting. */
+    struct _socketAsyncSend * pAsyncHead;   /* Cellular_SocketSendAsync requests, protected by txLock. */
+    bool sendQueued;                /* A WORKER_JOB_SEND for this socket is queued, protected by txLock. */
+
+    /* Handle lifetime, protected by socketLock. Kept by _Cellular_SocketModuleDataReset. */
+    uint32_t generation;            /* Incremented when the socket handle is removed. */
+    uint32_t callbackRefs;          /* Callbacks running with the handle, see _Cellular_SocketPin. */
+    bool removePending;             /* Closed while a callback ran. The last unpin removes the handle. */
+    CellularContext_t * pRemoveContext;
+    CellularSocketHandle_t removeHandle;
+} cellularSocketModuleData_t;
+
+/**
+ * @brief Command of an AT batch, see _Cellular_AtBatchSend.
+ */
+typedef struct cellularAtBatchCmd
+{
+    const char * pAtCmd;        /* "AT..." setting without an information response. */
+    CellularError_t status;     /* Result of the command. */
+} cellularAtBatchCmd_t;
+
+/**
+ * @brief Jobs run by the module worker task.
+ */
+typedef enum cellularWorkerJobType
+{
+    WORKER_JOB_RX_FETCH,    /* Fill the RX ring of socketId with AT+CARECV. */
+    WORKER_JOB_TX_TIMER,    /* Coalesced data is waiting. Recompute the flush deadline. */
+    WORKER_JOB_SEND,        /* Send the Cellular_SocketSendAsync requests of socketId. */
+    WORKER_JOB_DNS_TIMER,   /* An asynchronous DNS query started. Recompute its timeout. */
+    WORKER_JOB_PDN_TIMER,   /* An asynchronous PDN activation started or got its +APP PDP. */
+    WORKER_JOB_EXIT         /* Stop the worker task. */
+} cellularWorkerJobType_t;
+
+typedef struct cellularWorkerJob
+{
+    cellularWorkerJobType_t jobType;
+    CellularContext_t * pContext;
+    uint32_t socketId;
+    void * pJobData;        /* Job specific data, owned by the job. */
+} cellularWorkerJob_t;
+
+/**
+ * @brief Socket callbacks run by the callback dispatch task.
+ */
+typedef enum cellularCallbackType
+{
+    CALLBACK_SOCKET_OPEN,       /* openCallback with urcEvent. */
+    CALLBACK_SOCKET_CLOSED,     /* closedCallback. */
+    CALLBACK_SOCKET_DATA_READY, /* dataReadyCallback. */
+    CALLBACK_EXIT               /* Stop the dispatch task. */
+} cellularCallbackType_t;
+
+typedef struct cellularCallbackEvent
+{
+    cellularCallbackType_t callbackType;
+    const CellularContext_t * pContext;
+    uint32_t socketId;
+    CellularSocketContext_t * pSocketData;  /* Only used while pinned with generation. */
+    uint32_t generation;                    /* Of the socket when the event was queued. */
+    CellularUrcEvent_t urcEvent;
+} cellularCallbackEvent_t;
+
+/**
+ * @brief Deferred callback statistics, see Cellular_GetCallbackStats.
+ */
+typedef struct cellularCallbackStats
+{
+    uint32_t queued;        /* Callbacks posted to the dispatch task. */
+    uint32_t dispatched;    /* Callbacks run by the dispatch task. */
+    uint32_t coalesced;     /* Data ready callbacks merged into a waiting one. */
+    uint32_t overflows;     /* Callbacks run in the URC context because the queue was full. */
+    uint32_t stale;         /* Callbacks dropped because the socket was closed meanwhile. */
+    uint32_t maxQueued;     /* High water mark of the queue. */
+} cellularCallbackStats_t;
 
 /**
- * @brief DNS query URC callback fucntion.
+ * @brief Startup statistics, see Cellular_GetStartupStats.
  */
-typedef void (*CellularDnsResultEventCallback_t)(cellularModuleContext_t* pModuleContext,
-    char* pDnsResult,
-    char* pDnsUsrData);
+typedef struct cellularStartupStats
+{
+    bool diffMode;              /* CELLULAR_SIM70X0_STARTUP_DIFF is enabled. */
+    uint8_t sentCount;          /* Settings sent. */
+    uint8_t skippedCount;       /* Settings the modem had already. */
+    const char * pSkippedCmds[ CELLULAR_SIM70X0_STARTUP_CMD_MAX ];
+    bool profileSaved;          /* AT&W was sent. */
+    uint32_t readMs;            /* Round trip of the query line. */
+    uint32_t cmdMs;             /* Round trip of ATE0, a single setting. */
+    uint32_t elapsedMs;         /* Time to read, send and save the settings. */
+    uint32_t savedMs;           /* cmdMs for each skipped setting. */
+} cellularStartupStats_t;
+
+typedef struct cellularModuleContext cellularModuleContext_t;
 
 struct cellularModuleContext
 {
     /* DNS related variables. */
     PlatformMutex_t dnsQueryMutex; /* DNS query mutex to protect the following data. */
-    QueueHandle_t pktDnsQueue;     /* DNS queue to receive the DNS query result. */
-    uint8_t dnsResultNumber;       /* DNS query result number. */
-    uint8_t dnsIndex;              /* DNS query current index. */
-    char * pDnsUsrData;            /* DNS user data to store the result. */
-    CellularDnsResultEventCallback_t dnsEventCallback;
-
-    const CellularPdnConfig_t*  pPdnCfg;
-    EventGroupHandle_t          pdnEvent;   /* for AT+CNACT wait +APP PDP: response     */
+    cellularDnsQuery_t dnsQueries[ CELLULAR_SIM70X0_DNS_MAX_QUERIES ];
+    uint32_t dnsQuerySequence;     /* Sequence of the last AT+CDNSGIP. */
+    uint32_t dnsUnanswered;        /* AT+CDNSGIP sent and waiting for +CDNSGIP, timed out ones included. */
+    TickType_t dnsUnansweredTick;  /* Start of the unanswered AT+CDNSGIP with the latest deadline. */
+    uint32_t dnsUnansweredWaitMs;  /* Its wait, dnsUnanswered is cleared once it has passed. */
+    uint32_t dnsRequestId;         /* ID of the last Cellular_GetHostByNameAsync request. */
+    EventGroupHandle_t dnsEvent;   /* Query completion, one DNS_EVENT_BIT per slot. */
+    SemaphoreHandle_t dnsCacheLock;         /* Protects dnsCache and dnsCacheStats. */
+    cellularDnsCacheEntry_t dnsCache[ CELLULAR_SIM70X0_DNS_CACHE_SIZE ];
+    cellularDnsCacheStats_t dnsCacheStats;
+
+    SemaphoreHandle_t           pdnLock;    /* Protects the state and activation requests in pdnContexts. */
+    cellularPdnContext_t        pdnContexts[ CELLULAR_CID_MAX + 1 ];    /* Indexed by CID. */
+    bool                        pdnStateRefreshed;  /* AT+CNACT? was read once, every CID is in pdnContexts. */
+    EventGroupHandle_t          pdnEvent;   /* module events, see cellularEventBit_t and PDN_EVENT_BIT */
+
+    /* Socket related variables. */
+    cellularSocketModuleData_t socketData[ CELLULAR_NUM_SOCKET_MAX ];
+    SemaphoreHandle_t socketLock;       /* Protects the handle lifetime fields of socketData and callbackQueue. Never held across a callback. */
+    EventGroupHandle_t rxDataEvent;     /* RX readiness, one RX_DATA_EVENT_BIT per socket ID. */
+
+    /* Worker task running AT command jobs which can't run in the URC context. */
+    QueueHandle_t workerQueue;
+
+    /* Dispatch task running application socket callbacks. NULL if callbacks run in the URC context. */
+    QueueHandle_t callbackQueue;
+    cellularCallbackStats_t callbackStats;
+
+    cellularStartupStats_t startupStats;
 };
 
 
@@ -111,6 +528,340 @@ extern uint32_t CellularUrcTokenWoPrefixTableSize;
 extern BOOL    IsValidCID(int cid);
 extern BOOL    IsValidSockID(int sid);
 
+bool _Cellular_PostWorkerJob( cellularModuleContext_t * pModuleContext,
+                              const cellularWorkerJob_t * pJob );
+
+/**
+ * @brief Send AT commands concatenated into as few command lines as fit.
+ *
+ * "ATE0", "AT+A=1" and "AT+B=2" go out as "ATE0+A=1;+B=2", in the order
+ * given. The modem only returns one final result for a line and stops at
+ * the first failing command. If a combined line fails, each of its
+ * commands is sent again on its own, up to tryCount times, to get its
+ * status. The commands must be safe to repeat. Returns the first failure.
+ */
+CellularError_t _Cellular_AtBatchSend( CellularContext_t * pContext,
+                                       cellularAtBatchCmd_t * pCmds,
+                                       uint32_t numCmds,
+                                       uint32_t timeoutMs,
+                                       uint8_t tryCount );
+
+void _Cellular_RequestRxFetch( CellularContext_t * pContext,
+                               cellularModuleContext_t * pModuleContext,
+                               uint32_t socketId );
+
+CellularError_t _Cellular_SocketRxFetch( CellularContext_t * pContext,
+                                         uint32_t socketId );
+
+void _Cellular_SocketModuleDataReset( cellularModuleContext_t * pModuleContext,
+                                      uint32_t socketId );
+
+TickType_t _Cellular_SocketTxFlushExpired( CellularContext_t * pContext,
+                                           cellularModuleContext_t * pModuleContext );
+
+void _Cellular_SocketSendAsyncJob( CellularContext_t * pContext,
+                                   uint32_t socketId );
+
+/**
+ * @brief Keep the handle of a socket allocated while a callback uses it.
+ *
+ * Fails if the socket handle was removed since generation was read or is
+ * being closed. Every successful pin is paired with _Cellular_SocketUnpin.
+ */
+bool _Cellular_SocketPin( cellularModuleContext_t * pModuleContext,
+                          uint32_t socketId,
+                          uint32_t generation );
+
+void _Cellular_SocketUnpin( cellularModuleContext_t * pModuleContext,
+                            uint32_t socketId );
+
+/**
+ * @brief Remove a socket handle, or let the last unpin remove it.
+ */
+CellularError_t _Cellular_SocketRemove( CellularContext_t * pContext,
+                                        cellularModuleContext_t * pModuleContext,
+                                        CellularSocketHandle_t socketHandle );
+
+bool _Cellular_DnsQueryComplete( cellularModuleContext_t * pModuleContext,
+                                 const char * pHostName,
+                                 const cellularDnsResult_t * pDnsResult );
+
+TickType_t _Cellular_DnsQueryDispatch( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_DnsQueryReset( cellularModuleContext_t * pModuleContext );
+
+TickType_t _Cellular_PdnActivateDispatch( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_PdnStateUpdate( cellularModuleContext_t * pModuleContext,
+                               uint8_t cid,
+                               bool active );
+
+void _Cellular_PdnStateInvalidate( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_SocketCallback( const CellularContext_t * pContext,
+                               cellularCallbackType_t callbackType,
+                               CellularSocketContext_t * pSocketData,
+                               CellularUrcEvent_t urcEvent );
+
+/**
+ * @brief Set a SIM70x0 specific socket option.
+ *
+ * CELLULAR_SOCKET_MODULE_OPT_RX_BUFFER_SIZE enables a receive ring for the
+ * socket. The module worker fills it with AT+CARECV as soon as +CADATAIND
+ * is received and Cellular_SocketRecv is served from the ring.
+ *
+ * CELLULAR_SOCKET_MODULE_OPT_RECV_NONBLOCKING makes Cellular_SocketRecv
+ * return CELLULAR_SUCCESS with 0 bytes at once when no data is indicated.
+ * Otherwise the receive timeout of the socket bounds the whole call.
+ *
+ * CELLULAR_SOCKET_MODULE_OPT_RECV_DRAIN makes Cellular_SocketRecv issue
+ * back-to-back AT+CARECV until the buffer is full, the modem reports
+ * +CARECV: 0 or the receive timeout expires. The total length is returned.
+ *
+ * CELLULAR_SOCKET_MODULE_OPT_TX_COALESCE_SIZE makes Cellular_SocketSend
+ * collect small writes and send them in one AT+CASEND once this many bytes
+ * are waiting, CELLULAR_SOCKET_MODULE_OPT_TX_COALESCE_TIMEOUT expires or
+ * Cellular_SocketFlush is called. A write that doesn't fit is sent directly.
+ *
+ * CELLULAR_SOCKET_MODULE_OPT_SEND_ALL makes Cellular_SocketSend accept data
+ * larger than CELLULAR_MAX_SEND_DATA_LEN. The next AT+CASEND is issued as
+ * soon as the previous chunk is acknowledged, until all data is sent or the
+ * send timeout of the socket expires. The sent length is returned.
+ *
+ * CELLULAR_SOCKET_MODULE_OPT_TX_WINDOW limits the bytes in flight. Before
+ * each AT+CASEND, coalesced flushes included, the unacknowledged length is
+ * read with AT+CAACK and the chunk is cut to the free window. If the window
+ * is full Cellular_SocketSend polls AT+CAACK every
+ * CELLULAR_SIM70X0_TX_WINDOW_POLL_MS until it opens or the send timeout
+ * expires, then returns CELLULAR_SUCCESS with 0 bytes. With
+ * CELLULAR_SOCKET_MODULE_OPT_SEND_NONBLOCKING it returns at once. The module
+ * worker never waits: Cellular_SocketSendAsync completes with what fit and a
+ * timed flush leaves the rest for the next flush timeout.
+ *
+ * There is no option for transparent data mode (AT+CASWITCH). The packet
+ * I/O task of the common library owns the comm interface and parses every
+ * received byte as a response or URC, so it can't be handed to a raw data
+ * stream. For bulk transfers combine CELLULAR_SOCKET_MODULE_OPT_SEND_ALL
+ * with CELLULAR_SOCKET_MODULE_OPT_RX_BUFFER_SIZE and
+ * CELLULAR_SOCKET_MODULE_OPT_RECV_DRAIN.
+ */
+CellularError_t Cellular_SocketSetModuleOpt( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle,
+                                             cellularSocketModuleOption_t option,
+                                             const uint8_t * pOptionValue,
+                                             uint32_t optionValueLength );
+
+/**
+ * @brief Send the data coalesced on a socket now.
+ *
+ * Returns CELLULAR_SUCCESS if nothing is waiting.
+ */
+CellularError_t Cellular_SocketFlush( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle );
+
+/**
+ * @brief Queue a send to the module worker and return at once.
+ *
+ * sendCallback is called with the result when the worker has sent the data.
+ * If copyData is false the caller must keep pData valid until then. If it is
+ * true the data is copied and pData may be reused when this returns.
+ * Requests of a socket are sent in order. CELLULAR_NO_MEMORY is returned if
+ * the request can't be allocated or the worker queue is full.
+ */
+CellularError_t Cellular_SocketSendAsync( CellularHandle_t cellularHandle,
+                                          CellularSocketHandle_t socketHandle,
+                                          const uint8_t * pData,
+                                          uint32_t dataLength,
+                                          bool copyData,
+                                          CellularSocketSendCallback_t sendCallback,
+                                          void * pCallbackContext );
+
+/**
+ * @brief Send several buffer segments with one AT+CASEND.
+ *
+ * The total length must not exceed CELLULAR_MAX_SEND_DATA_LEN. Two segments
+ * are sent without a copy, more segments are gathered except for the last.
+ * Coalesced data of the socket is flushed first.
+ */
+CellularError_t Cellular_SocketSendv( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle,
+                                      const cellularSocketIoVec_t * pIoVec,
+                                      uint32_t ioVecCount,
+                                      uint32_t * pSentDataLength );
+
+/**
+ * @brief Receive one +CARECV payload scattered over several buffer segments.
+ *
+ * The segments are filled in order. Timeout and non-blocking behave as in
+ * Cellular_SocketRecv. CELLULAR_SOCKET_MODULE_OPT_RECV_DRAIN is not applied.
+ */
+CellularError_t Cellular_SocketRecvv( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle,
+                                      const cellularSocketIoVec_t * pIoVec,
+                                      uint32_t ioVecCount,
+                                      uint32_t * pReceivedDataLength );
+
+/**
+ * @brief Get the AT+CASEND statistics of a socket.
+ *
+ * The statistics are cleared when the socket is closed.
+ */
+CellularError_t Cellular_SocketGetSendStats( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle,
+                                             cellularSocketSendStats_t * pSendStats );
+
+/**
+ * @brief Get the +CADATAIND statistics of a socket.
+ *
+ * The data ready callback is edge triggered. After it is called, further
+ * +CADATAIND of the socket are only counted until a receive sees
+ * +CARECV: 0. Read until Cellular_SocketRecv returns 0 bytes to re-arm it.
+ * The statistics are cleared when the socket is closed.
+ */
+CellularError_t Cellular_SocketGetRecvStats( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle,
+                                             cellularSocketRecvStats_t * pRecvStats );
+
+/**
+ * @brief Read the sent and unacknowledged length of a socket with AT+CAACK.
+ */
+CellularError_t Cellular_SocketGetAckInfo( CellularHandle_t cellularHandle,
+                                           CellularSocketHandle_t socketHandle,
+                                           cellularSocketAckInfo_t * pAckInfo );
+
+/**
+ * @brief Activate several PDN contexts at once.
+ *
+ * AT+CNCFG and AT+CNACT are sent for every context first, then the +APP PDP
+ * URCs of all of them are awaited together for up to
+ * PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS. pStatuses receives the result of
+ * each context. The first failure is returned.
+ */
+CellularError_t Cellular_ActivatePdnMulti( CellularHandle_t cellularHandle,
+                                           const uint8_t * pContextIds,
+                                           uint8_t numContexts,
+                                           CellularError_t * pStatuses );
+
+/**
+ * @brief Start the activation of a PDN context and return without waiting
+ * for the network.
+ *
+ * Returns once the modem accepted AT+CNACT=<cid>,1. callback is run by the
+ * module worker task when +APP PDP arrives for the context or the
+ * activation times out. Returns CELLULAR_NOT_ALLOWED if an activation of the
+ * context is pending already.
+ */
+CellularError_t Cellular_ActivatePdnAsync( CellularHandle_t cellularHandle,
+                                           uint8_t contextId,
+                                           CellularPdnActivateCallback_t callback,
+                                           void * pUserData );
+
+/**
+ * @brief Cellular_GetPdnStatus with control over the state cache.
+ *
+ * The states are kept up to date by the URCs and by the activation and
+ * deactivation results. AT+CNACT? is only sent if forceRefresh is set,
+ * the cache was never filled or dropped by a modem reset or power down, or
+ * the address of an activated context isn't known yet. If pStateTicks
+ * isn't NULL it receives, for each status, the tick count of its last
+ * update. It must hold numStatusBuffers entries. Cellular_GetPdnStatus is
+ * this call without forceRefresh.
+ */
+CellularError_t Cellular_GetPdnStatusCached( CellularHandle_t cellularHandle,
+                                             CellularPdnStatus_t * pPdnStatusBuffers,
+                                             TickType_t * pStateTicks,
+                                             uint8_t numStatusBuffers,
+                                             uint8_t * pNumStatus,
+                                             bool forceRefresh );
+
+/**
+ * @brief Resolve pcHostName and return every address +CDNSGIP reports.
+ *
+ * Shares the DNS cache and the query slots with Cellular_GetHostByName,
+ * which returns the first of these addresses.
+ */
+CellularError_t Cellular_GetHostByNameAll( CellularHandle_t cellularHandle,
+                                           uint8_t contextId,
+                                           const char * pcHostName,
+                                           cellularDnsResult_t * pDnsResult );
+
+/**
+ * @brief Start resolving pcHostName and return without waiting for it.
+ *
+ * The result is passed to callback from the +CDNSGIP URC handler, or from
+ * the module worker task if no result arrives within timeoutMs. A cached
+ * result is passed before this function returns. The callback must not
+ * block or send AT commands. timeoutMs is also the AT+CDNSGIP timeout.
+ * pRequestId identifies the request for Cellular_GetHostByNameCancel.
+ */
+CellularError_t Cellular_GetHostByNameAsync( CellularHandle_t cellularHandle,
+                                             uint8_t contextId,
+                                             const char * pcHostName,
+                                             uint32_t timeoutMs,
+                                             CellularDnsCallback_t callback,
+                                             void * pUserData,
+                                             uint32_t * pRequestId );
+
+/**
+ * @brief Cancel a request of Cellular_GetHostByNameAsync.
+ *
+ * Its callback isn't called afterwards. Returns CELLULAR_BAD_PARAMETER if
+ * the request has completed already. The AT+CDNSGIP already sent runs to
+ * its end in the modem.
+ */
+CellularError_t Cellular_GetHostByNameCancel( CellularHandle_t cellularHandle,
+                                              uint32_t requestId );
+
+/**
+ * @brief Connect a socket to the first address of pDnsResult which answers.
+ *
+ * The addresses are tried in order on socketHandle, each for at most
+ * CELLULAR_SIM70X0_CONNECT_ATTEMPT_TIMEOUT_MS. A failed attempt returns the
+ * socket to the allocated state before the next address is tried. The open
+ * callback of the socket is called for every attempt. pConnectedIndex is the
+ * index of the connected address.
+ */
+CellularError_t Cellular_SocketConnectAny( CellularHandle_t cellularHandle,
+                                           CellularSocketHandle_t socketHandle,
+                                           CellularSocketAccessMode_t dataAccessMode,
+                                           const cellularDnsResult_t * pDnsResult,
+                                           uint16_t port,
+                                           uint8_t * pConnectedIndex );
+
+/**
+ * @brief Remove entries from the DNS cache of Cellular_GetHostByName.
+ *
+ * Removes pcHostName of all PDN contexts, or every entry if pcHostName is
+ * NULL. Call it when cached addresses are known to be wrong, for example
+ * after the PDN changed.
+ */
+CellularError_t Cellular_DnsCacheFlush( CellularHandle_t cellularHandle,
+                                        const char * pcHostName );
+
+/**
+ * @brief Get the DNS cache statistics.
+ */
+CellularError_t Cellular_GetDnsCacheStats( CellularHandle_t cellularHandle,
+                                           cellularDnsCacheStats_t * pDnsCacheStats );
+
+/**
+ * @brief Get the statistics of the deferred callback dispatch.
+ *
+ * All counters stay 0 unless CELLULAR_SIM70X0_DEFER_CALLBACKS is enabled.
+ */
+CellularError_t Cellular_GetCallbackStats( CellularHandle_t cellularHandle,
+                                           cellularCallbackStats_t * pCallbackStats );
+
+/**
+ * @brief Get the statistics of the last Cellular_ModuleEnableUE.
+ *
+ * Only diffMode is set unless CELLULAR_SIM70X0_STARTUP_DIFF is enabled.
+ * savedMs counts the measured ATE0 round trip for each skipped setting.
+ * readMs is what the query line cost in return.
+ */
+CellularError_t Cellular_GetStartupStats( CellularHandle_t cellularHandle,
+                                          cellularStartupStats_t * pStartupStats );
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -59,8 +59,14 @@
 #define COPS_POS_MCC_MNC_OPER_NAME                 ( 3U )
 #define COPS_POS_RAT                               ( 4U )
 
-/* AT command timeout for Get IP Address by Domain Name. */
-#define DNS_QUERY_TIMEOUT_MS                       ( 60000UL )
+/* Wait for +CDNSGIP beyond the AT+CDNSGIP timeout. */
+#define DNS_QUERY_MARGIN_MS                        ( 5000U )
+
+/* Poll interval of Cellular_SocketConnectAny for a +CAOPEN following the OK. */
+#define CONNECT_ATTEMPT_POLL_MS                    ( 50U )
+
+/* Timeout of each command of Cellular_SetPdnConfig. */
+#define PDN_CONFIG_CMD_TIMEOUT_MS                  ( 5000U )
 
 /* Length of HPLMN including RAT. */
 #define CRSM_HPLMN_RAT_LENGTH                      ( 9U )
@@ -104,6 +110,18 @@
 
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief States of the +CARECV data prefix parser.
+ */
+typedef enum _recvPrefixState
+{
+    RECV_PREFIX_STATE_MATCH = 0,    /* Matching "+CARECV:". */
+    RECV_PREFIX_STATE_SPACE,        /* Skipping spaces before the length. */
+    RECV_PREFIX_STATE_LENGTH,       /* Reading the length digits. */
+    RECV_PREFIX_STATE_PAYLOAD,      /* The payload follows the comma. */
+    RECV_PREFIX_STATE_OTHER         /* Not +CARECV, waiting for the end of the line. */
+} _recvPrefixState_t;
+
 /**
  * @brief Parameters involved in receiving data through sockets
  */
@@ -112,8 +130,32 @@ typedef struct _socketDataRecv
     uint32_t * pDataLen;
     uint8_t * pData;
     CellularSocketAddress_t * pRemoteSocketAddress;
+    CellularContext_t * pContext;
+    CellularSocketHandle_t socketHandle;
+    uint32_t dataBufSize;   /* Size of pData in bytes. */
+    bool dataDelivered;     /* Set when socketRecvDataPrefix copied the payload to pData. */
+    _recvPrefixState_t prefixState;     /* Data prefix parser state, kept across partial reads. */
+    uint32_t prefixOffset;              /* Bytes of the line already parsed. */
+    uint32_t prefixLineStart;           /* Offset of the line after skipped line endings. */
+    uint32_t prefixDataLen;             /* Payload length parsed from the prefix. */
+    const cellularSocketIoVec_t * pIoVec;   /* Segments the payload is scattered over. */
+    uint32_t ioVecCount;
 } _socketDataRecv_t;
 
+/**
+ * @brief Cellular_SocketSendAsync request, queued on pAsyncHead of the socket.
+ */
+typedef struct _socketAsyncSend
+{
+    struct _socketAsyncSend * pNext;
+    CellularSocketHandle_t socketHandle;
+    uint32_t generation;        /* Of the socket when the request was queued. */
+    const uint8_t * pData;      /* The caller's buffer, or the copy behind this structure. */
+    uint32_t dataLength;
+    CellularSocketSendCallback_t sendCallback;
+    void * pCallbackContext;
+} _socketAsyncSend_t;
+
 /*-----------------------------------------------------------*/
 
 static bool _parseSignalQuality( char * pQcsqPayload,
@@ -195,6 +237,9 @@ static CellularPktStatus_t _Cellular_RecvFuncGetPsmSettings( CellularContext_t *
                                                              const CellularATCommandResponse_t * pAtResp,
                                                              void * pData,
                                                              uint16_t dataLen );
+static CellularPktStatus_t parseRecvDataPrefix( _socketDataRecv_t * pDataRecv,
+                                                const char * pLine,
+                                                uint32_t lineLength );
 static CellularPktStatus_t socketRecvDataPrefix( void * pCallbackContext,
                                                  char * pLine,
                                                  uint32_t lineLength,
@@ -204,12 +249,70 @@ static CellularError_t storeAccessModeAndAddress( CellularContext_t * pContext,
                                                   CellularSocketHandle_t socketHandle,
                                                   CellularSocketAccessMode_t dataAccessMode,
                                                   const CellularSocketAddress_t * pRemoteSocketAddress );
-static CellularError_t registerDnsEventCallback( cellularModuleContext_t * pModuleContext,
-                                                 CellularDnsResultEventCallback_t dnsEventCallback,
-                                                 char * pDnsUsrData );
-static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
-                                char * pDnsResult,
-                                char * pDnsUsrData );
+static uint32_t dnsQueryWaitMs( uint32_t timeoutMs );
+static uint32_t dnsNextRequestId( cellularModuleContext_t * pModuleContext );
+static uint32_t dnsQueryStart( cellularModuleContext_t * pModuleContext,
+                               uint8_t contextId,
+                               const char * pcHostName,
+                               uint32_t waitMs,
+                               CellularDnsCallback_t callback,
+                               void * pUserData,
+                               uint32_t requestId,
+                               bool * pSendQuery );
+static CellularError_t dnsQuerySend( CellularContext_t * pContext,
+                                     uint8_t contextId,
+                                     const char * pcHostName,
+                                     uint32_t timeoutMs );
+static void dnsQueryFinish( cellularModuleContext_t * pModuleContext,
+                            uint32_t sequence,
+                            cellularDnsQueryResult_t dnsQueryResult,
+                            const cellularDnsResult_t * pDnsResult );
+static void dnsQueryAbort( cellularModuleContext_t * pModuleContext,
+                           uint32_t queryIndex );
+static void dnsUnansweredExpire( cellularModuleContext_t * pModuleContext );
+static bool dnsQueryRelease( cellularModuleContext_t * pModuleContext,
+                             uint32_t queryIndex,
+                             cellularDnsQueryResult_t * pDnsQueryResult,
+                             cellularDnsResult_t * pDnsResult );
+static CellularError_t dnsQueryStatus( cellularModuleContext_t * pModuleContext,
+                                       uint8_t contextId,
+                                       const char * pcHostName,
+                                       bool done,
+                                       cellularDnsQueryResult_t dnsQueryResult,
+                                       const cellularDnsResult_t * pDnsResult );
+static bool dnsCacheEntryLive( const cellularDnsCacheEntry_t * pEntry,
+                               TickType_t nowTick );
+static cellularDnsCacheEntry_t * dnsCacheFind( cellularModuleContext_t * pModuleContext,
+                                               uint8_t contextId,
+                                               const char * pcHostName );
+static bool dnsCacheLookup( cellularModuleContext_t * pModuleContext,
+                            uint8_t contextId,
+                            const char * pcHostName,
+                            cellularDnsResult_t * pDnsResult,
+                            CellularError_t * pCachedStatus );
+static void dnsCacheStore( cellularModuleContext_t * pModuleContext,
+                           uint8_t contextId,
+                           const char * pcHostName,
+                           const cellularDnsResult_t * pDnsResult );
+static CellularError_t getHostByName( CellularContext_t * pContext,
+                                      uint8_t contextId,
+                                      const char * pcHostName,
+                                      cellularDnsResult_t * pDnsResult );
+static bool pdnContextCid( uint8_t contextId,
+                           uint8_t * pCid );
+static CellularError_t pdnActivateStart( CellularContext_t * pContext,
+                                         cellularModuleContext_t * pModuleContext,
+                                         uint8_t cid );
+static CellularError_t pdnStateRefresh( CellularContext_t * pContext,
+                                        cellularModuleContext_t * pModuleContext );
+static CellularError_t pdnReadAddress( CellularContext_t * pContext,
+                                       cellularModuleContext_t * pModuleContext,
+                                       uint8_t cid,
+                                       char * pIpAddress );
+static CellularError_t socketConnectAttempt( CellularContext_t * pContext,
+                                             CellularSocketHandle_t socketHandle,
+                                             CellularSocketAccessMode_t dataAccessMode,
+                                             const CellularSocketAddress_t * pRemoteSocketAddress );
 static uint32_t appendBinaryPattern( char * cmdBuf,
                                      uint32_t cmdLen,
                                      uint32_t value,
@@ -217,6 +320,108 @@ static uint32_t appendBinaryPattern( char * cmdBuf,
 static CellularPktStatus_t socketSendDataPrefix( void * pCallbackContext,
                                                  char * pLine,
                                                  uint32_t * pBytesRead );
+static uint32_t remainingTimeMs( TickType_t startTick,
+                                 uint32_t timeoutMs );
+static uint32_t ioVecLength( const cellularSocketIoVec_t * pIoVec,
+                             uint32_t ioVecCount );
+static uint32_t copyRecvData( const _socketDataRecv_t * pDataRecv,
+                              const char * pSrc,
+                              uint32_t srcLength );
+static CellularError_t socketRecvData( CellularContext_t * pContext,
+                                       CellularSocketHandle_t socketHandle,
+                                       uint8_t * pBuffer,
+                                       uint32_t bufferLength,
+                                       uint32_t recvTimeout,
+                                       uint32_t * pReceivedDataLength );
+static CellularError_t socketRecvDataV( CellularContext_t * pContext,
+                                        CellularSocketHandle_t socketHandle,
+                                        const cellularSocketIoVec_t * pIoVec,
+                                        uint32_t ioVecCount,
+                                        uint32_t recvTimeout,
+                                        uint32_t * pReceivedDataLength );
+static uint32_t rxRingRead( cellularSocketModuleData_t * pSocketModuleData,
+                            uint8_t * pBuffer,
+                            uint32_t bufferLength );
+static CellularError_t rxRingFill( CellularContext_t * pContext,
+                                   CellularSocketHandle_t socketHandle,
+                                   cellularSocketModuleData_t * pSocketModuleData,
+                                   uint32_t recvTimeout,
+                                   bool drainModem );
+static CellularError_t socketRecvFromRing( CellularContext_t * pContext,
+                                           cellularModuleContext_t * pModuleContext,
+                                           CellularSocketHandle_t socketHandle,
+                                           const cellularSocketIoVec_t * pIoVec,
+                                           uint32_t ioVecCount,
+                                           uint32_t recvTimeout,
+                                           uint32_t * pReceivedDataLength );
+static CellularError_t socketRecv( CellularContext_t * pContext,
+                                   cellularModuleContext_t * pModuleContext,
+                                   CellularSocketHandle_t socketHandle,
+                                   const cellularSocketIoVec_t * pIoVec,
+                                   uint32_t ioVecCount,
+                                   uint32_t * pReceivedDataLength );
+static CellularError_t setRxBufferSize( cellularSocketModuleData_t * pSocketModuleData,
+                                        const uint8_t * pOptionValue,
+                                        uint32_t optionValueLength );
+static CellularError_t setTxCoalesceSize( cellularSocketModuleData_t * pSocketModuleData,
+                                          const uint8_t * pOptionValue,
+                                          uint32_t optionValueLength );
+static CellularError_t socketSendData( CellularContext_t * pContext,
+                                       CellularSocketHandle_t socketHandle,
+                                       const uint8_t * pData,
+                                       uint32_t dataLength,
+                                       const uint8_t * pTrailer,
+                                       uint32_t trailerLength,
+                                       uint32_t sendTimeout,
+                                       uint32_t * pSentDataLength );
+static void recordSendStats( cellularSocketSendStats_t * pSendStats,
+                             TickType_t chunkTick,
+                             uint32_t sentLength );
+static CellularError_t socketSendChunks( CellularContext_t * pContext,
+                                         CellularSocketHandle_t socketHandle,
+                                         cellularSocketModuleData_t * pSocketModuleData,
+                                         const uint8_t * pData,
+                                         uint32_t dataLength,
+                                         uint32_t sendTimeout,
+                                         bool waitWindow,
+                                         uint32_t * pSentDataLength );
+static CellularError_t socketSendIoVec( CellularContext_t * pContext,
+                                        CellularSocketHandle_t socketHandle,
+                                        cellularSocketModuleData_t * pSocketModuleData,
+                                        const cellularSocketIoVec_t * pIoVec,
+                                        uint32_t ioVecCount,
+                                        uint32_t * pSentDataLength );
+static CellularError_t socketTxFlush( CellularContext_t * pContext,
+                                      CellularSocketHandle_t socketHandle,
+                                      cellularSocketModuleData_t * pSocketModuleData,
+                                      bool waitWindow );
+static CellularError_t socketSendCoalesced( CellularContext_t * pContext,
+                                            cellularModuleContext_t * pModuleContext,
+                                            CellularSocketHandle_t socketHandle,
+                                            const uint8_t * pData,
+                                            uint32_t dataLength,
+                                            uint32_t sendTimeout,
+                                            bool waitWindow,
+                                            uint32_t * pSentDataLength );
+static CellularPktStatus_t _Cellular_RecvFuncGetAckInfo( CellularContext_t * pContext,
+                                                         const CellularATCommandResponse_t * pAtResp,
+                                                         void * pData,
+                                                         uint16_t dataLen );
+static CellularError_t socketGetAckInfo( CellularContext_t * pContext,
+                                         CellularSocketHandle_t socketHandle,
+                                         cellularSocketAckInfo_t * pAckInfo );
+static CellularError_t socketTxWindowWait( CellularContext_t * pContext,
+                                           CellularSocketHandle_t socketHandle,
+                                           const cellularSocketModuleData_t * pSocketModuleData,
+                                           uint32_t dataLength,
+                                           uint32_t waitTimeout,
+                                           uint32_t * pAllowedLength );
+static CellularError_t socketSend( CellularContext_t * pContext,
+                                   cellularModuleContext_t * pModuleContext,
+                                   CellularSocketHandle_t socketHandle,
+                                   const uint8_t * pData,
+                                   uint32_t dataLength,
+                                   uint32_t * pSentDataLength );
 
 /*-----------------------------------------------------------*/
 
@@ -1187,6 +1392,33 @@ static CellularError_t buildSocketConnect( CellularSocketHandle_t socketHandle,
 
 /*-----------------------------------------------------------*/
 
+/* Copy received data to the segments of the out buffer in order. */
+static uint32_t copyRecvData( const _socketDataRecv_t * pDataRecv,
+                              const char * pSrc,
+                              uint32_t srcLength )
+{
+    uint32_t copiedLen = 0;
+    uint32_t copyLen = 0;
+    uint32_t i = 0;
+
+    for( i = 0; ( i < pDataRecv->ioVecCount ) && ( copiedLen < srcLength ); i++ )
+    {
+        copyLen = srcLength - copiedLen;
+
+        if( copyLen > pDataRecv->pIoVec[ i ].bufferLength )
+        {
+            copyLen = pDataRecv->pIoVec[ i ].bufferLength;
+        }
+
+        ( void ) memcpy( pDataRecv->pIoVec[ i ].pBuffer, &pSrc[ copiedLen ], copyLen );
+        copiedLen = copiedLen + copyLen;
+    }
+
+    return copiedLen;
+}
+
+/*-----------------------------------------------------------*/
+
 static CellularATError_t getDataFromResp( const CellularATCommandResponse_t * pAtResp,
                                           const _socketDataRecv_t * pDataRecv,
                                           uint32_t outBufSize )
@@ -1218,7 +1450,7 @@ static CellularATError_t getDataFromResp( const CellularATCommandResponse_t * pA
         if( ( pInputLine != NULL ) && ( dataLenToCopy > 0U ) )
         {
             /* Copy the data to the out buffer. */
-            ( void ) memcpy( ( void * ) pDataRecv->pData, ( const void * ) pInputLine, dataLenToCopy );
+            ( void ) copyRecvData( pDataRecv, pInputLine, dataLenToCopy );
         }
         else
         {
@@ -1257,6 +1489,9 @@ static CellularPktStatus_t _Cellular_RecvFuncData( CellularContext_t * pContext,
     const _socketDataRecv_t * pDataRecv = ( _socketDataRecv_t * ) pData;
     int32_t tempValue = 0;
 
+    /* The out buffer size is carried in pDataRecv. dataLen is only 16 bits wide. */
+    ( void ) dataLen;
+
     if( pContext == NULL )
     {
         LogError( ( "Receive Data: invalid context" ) );
@@ -1272,6 +1507,12 @@ static CellularPktStatus_t _Cellular_RecvFuncData( CellularContext_t * pContext,
         LogError( ( "Receive Data: Bad param" ) );
         pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
     }
+    else if( pDataRecv->dataDelivered == true )
+    {
+        /* socketRecvDataPrefix already placed the payload in the out buffer
+         * while it was still in the pktio buffer. Nothing left to parse. */
+        LogDebug( ( "Receive Data: %u bytes delivered by data prefix", *pDataRecv->pDataLen ) );
+    }
     else
     {
         pInputLine = pAtResp->pItm->pLine;
@@ -1296,7 +1537,11 @@ static CellularPktStatus_t _Cellular_RecvFuncData( CellularContext_t * pContext,
                     if (tempValue == 0)
                     {
                         cellularModuleContext_t* pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
-                        xEventGroupClearBits(pSimContex->pdnEvent, EVENT_BIT_RX_DATA);  //no data in module
+                        ( void ) xSemaphoreTake( pSimContex->socketLock, portMAX_DELAY );
+                        pSimContex->socketData[ pDataRecv->socketHandle->socketId ].rxModemData = false;
+                        xEventGroupClearBits(pSimContex->rxDataEvent,
+                            RX_DATA_EVENT_BIT(pDataRecv->socketHandle->socketId));  //no data in module
+                        ( void ) xSemaphoreGive( pSimContex->socketLock );
                     }
                 }
                 else
@@ -1310,7 +1555,7 @@ static CellularPktStatus_t _Cellular_RecvFuncData( CellularContext_t * pContext,
         /* Process the data buffer. */
         if( atCoreStatus == CELLULAR_AT_SUCCESS )
         {
-            atCoreStatus = getDataFromResp( pAtResp, pDataRecv, dataLen );
+            atCoreStatus = getDataFromResp( pAtResp, pDataRecv, pDataRecv->dataBufSize );
         }
 
         pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
@@ -1614,141 +1859,255 @@ static CellularPktStatus_t _Cellular_RecvFuncGetPsmSettings( CellularContext_t *
 
 /*-----------------------------------------------------------*/
 
-#define MAX_CARECV_STRING_PREFIX_STRING 15              /* +CARECV: 1459,   */   
 #define DATA_PREFIX_STRING              "+CARECV:"
-#define DATA_PREFIX_STRING_LENGTH       8
-
-static CellularPktStatus_t socketRecvDataPrefix( void * pCallbackContext,
-                                                 char * pLine,
-                                                 uint32_t lineLength,
-                                                 char ** ppDataStart,
-                                                 uint32_t * pDataLength )
+#define DATA_PREFIX_STRING_LENGTH       8U
+#define DATA_IND_STRING                 "+CADATAIND:"
+#define DATA_IND_STRING_LENGTH          11U
+
+/* Parse the line from where the previous call stopped. Every byte is looked
+ * at once and nothing is copied. The state is left in pDataRecv so that a
+ * partial read of the prefix resumes instead of rescanning. */
+static CellularPktStatus_t parseRecvDataPrefix( _socketDataRecv_t * pDataRecv,
+                                                const char * pLine,
+                                                uint32_t lineLength )
 {
-    CellularContext_t* pContext = (CellularContext_t*)pCallbackContext;
-    char sPrefix[MAX_CARECV_STRING_PREFIX_STRING];
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_SIZE_MISMATCH;
+    uint32_t offset = pDataRecv->prefixOffset;
+    uint32_t lineLen = 0;
+    const char * pLineStart = NULL;
+    char ch = '\0';
 
-    /* Handling: +CARECV: 1459,<data>    */
-    if ((pLine == NULL) || (ppDataStart == NULL) || (pDataLength == NULL))
+    while( ( pktStatus == CELLULAR_PKT_STATUS_SIZE_MISMATCH ) &&
+           ( pDataRecv->prefixState != RECV_PREFIX_STATE_PAYLOAD ) && ( offset < lineLength ) )
     {
-        CellularLogError("Data prefix Bad Param(nul point)");
-        return CELLULAR_PKT_STATUS_BAD_PARAM;
-    }
+        ch = pLine[ offset ];
 
-    char* pData = strchr(pLine, ',');
-    char* pEos;
-    char* pPrefix;
-    char* pToken;
+        switch( pDataRecv->prefixState )
+        {
+            case RECV_PREFIX_STATE_MATCH:
 
-    *pDataLength = 0;
-    *ppDataStart = NULL;
+                if( ( offset == pDataRecv->prefixLineStart ) && ( ( ch == '\r' ) || ( ch == '\n' ) ) )
+                {
+                    /* Skip empty lines. */
+                    pDataRecv->prefixLineStart++;
+                }
+                else if( ch != DATA_PREFIX_STRING[ offset - pDataRecv->prefixLineStart ] )
+                {
+                    pDataRecv->prefixState = RECV_PREFIX_STATE_OTHER;
+                }
+                else if( ( offset - pDataRecv->prefixLineStart + 1U ) == DATA_PREFIX_STRING_LENGTH )
+                {
+                    pDataRecv->prefixState = RECV_PREFIX_STATE_SPACE;
+                }
+                else
+                {
+                    /* Keep matching. */
+                }
 
-    if ((pData != NULL) &&
-        (pData - pLine < MAX_CARECV_STRING_PREFIX_STRING) &&
-        (strncmp(pLine, "+CARECV:", 8) == 0))
-    {
-        goto ok; /* matched +CARECV: 1459,<data>    */
-    }
+                break;
 
-    /*
-     * OK
-     * +CADATAIND: 0
-     * +CARECV: 0
-     */
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+            case RECV_PREFIX_STATE_SPACE:
+
+                if( ( ch >= '0' ) && ( ch <= '9' ) )
+                {
+                    pDataRecv->prefixDataLen = ( uint32_t ) ( ch - '0' );
+                    pDataRecv->prefixState = RECV_PREFIX_STATE_LENGTH;
+                }
+                else if( ch != ' ' )
+                {
+                    pktStatus = CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+                }
+                else
+                {
+                    /* Skip spaces. */
+                }
 
-    pData = pLine;
+                break;
 
-    while (pData - pLine < (int)lineLength &&
-        (pEos = strchr(pData, '\r')) != NULL &&
-        pEos - pLine < (int)lineLength)
-    {
-        int nLen = min(sizeof(sPrefix) - 1, pEos - pData);
-        strncpy(sPrefix, pData, nLen);
-        sPrefix[nLen] = 0;
+            case RECV_PREFIX_STATE_LENGTH:
 
-        pData = ++pEos;
+                if( ( ch >= '0' ) && ( ch <= '9' ) )
+                {
+                    pDataRecv->prefixDataLen = ( pDataRecv->prefixDataLen * 10U ) + ( uint32_t ) ( ch - '0' );
 
-        while (*pData == '\n' || *pData == '\r')
-        {
-            pData++;
+                    if( pDataRecv->prefixDataLen > ( uint32_t ) CELLULAR_MAX_RECV_DATA_LEN )
+                    {
+                        LogError( ( "Data response received with wrong size: %u", pDataRecv->prefixDataLen ) );
+                        pktStatus = CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+                    }
+                }
+                else if( ch == ',' )
+                {
+                    /* The payload starts after the comma. */
+                    pDataRecv->prefixState = RECV_PREFIX_STATE_PAYLOAD;
+                }
+                else if( ( ch == '\r' ) && ( pDataRecv->prefixDataLen == 0U ) )
+                {
+                    /* +CARECV: 0 */
+                    pktStatus = CELLULAR_PKT_STATUS_OK;
+                }
+                else
+                {
+                    pktStatus = CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+                }
+
+                break;
+
+            case RECV_PREFIX_STATE_OTHER:
+
+                if( ch == '\r' )
+                {
+                    pLineStart = &pLine[ pDataRecv->prefixLineStart ];
+                    lineLen = offset - pDataRecv->prefixLineStart;
+
+                    /* OK and +CADATAIND are expected in the AT+CARECV response. */
+                    if( ( ( lineLen == 2U ) && ( strncmp( pLineStart, "OK", 2U ) == 0 ) ) ||
+                        ( ( lineLen >= DATA_IND_STRING_LENGTH ) &&
+                          ( strncmp( pLineStart, DATA_IND_STRING, DATA_IND_STRING_LENGTH ) == 0 ) ) )
+                    {
+                        pktStatus = CELLULAR_PKT_STATUS_OK;
+                    }
+                    else
+                    {
+                        pktStatus = CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+                    }
+                }
+
+                break;
+
+            default:
+                pktStatus = CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+                break;
         }
 
-        pPrefix = sPrefix;
-        Cellular_ATRemoveAllWhiteSpaces(pPrefix);
+        offset++;
+    }
+
+    pDataRecv->prefixOffset = offset;
 
-        if (strlen(pPrefix) <= 0)
+    if( pktStatus == CELLULAR_PKT_STATUS_SIZE_MISMATCH )
+    {
+        if( pDataRecv->prefixState == RECV_PREFIX_STATE_PAYLOAD )
         {
-            continue; /* empty line   */
+            if( ( lineLength - offset ) >= pDataRecv->prefixDataLen )
+            {
+                pktStatus = CELLULAR_PKT_STATUS_OK;
+            }
+            else
+            {
+                LogDebug( ( "need more data %u < %u", lineLength, offset + pDataRecv->prefixDataLen ) );
+            }
         }
-
-        /* Check if the message is a data related response. */
-        if ((strcmp(pPrefix, "OK") == 0) ||
-            (strncmp(pPrefix, "+CADATAIND:", 11) == 0))
+        else if( pDataRecv->prefixState == RECV_PREFIX_STATE_OTHER )
         {
-            CellularLogDebug("%s recieved. just ignore", pPrefix);
-            pktStatus = CELLULAR_PKT_STATUS_OK;
-            continue;
+            /* Not a data prefix. pktio handles the line once it is complete. */
+            pktStatus = CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
         }
-
-        if (strcmp(pPrefix, "+CARECV:0") == 0)
+        else
         {
-            CellularLogDebug("%s recieved. no more data", pPrefix);
-            cellularModuleContext_t* pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
-            xEventGroupClearBits(pSimContex->pdnEvent, EVENT_BIT_RX_DATA); /* recv data empty, need wait +CADATAIND: */
-            pktStatus = CELLULAR_PKT_STATUS_OK;
-            continue;
+            /* The prefix is not complete yet. Resume from here on the next call. */
         }
-
-        CellularLogError("not match(+CARECV).line: %s", sPrefix);
-        pktStatus = CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
     }
 
     return pktStatus;
+}
 
-ok: /* +CARECV: 1459,<data> come here */
-    pPrefix = sPrefix;
-    strncpy(sPrefix, pLine, pData - pLine);
-    sPrefix[pData - pLine] = 0;
+/*-----------------------------------------------------------*/
+
+static CellularPktStatus_t socketRecvDataPrefix( void * pCallbackContext,
+                                                 char * pLine,
+                                                 uint32_t lineLength,
+                                                 char ** ppDataStart,
+                                                 uint32_t * pDataLength )
+{
+    _socketDataRecv_t * pDataRecv = ( _socketDataRecv_t * ) pCallbackContext;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    char * pData = NULL;
+    uint32_t copyLen = 0;
 
-    if (CELLULAR_AT_SUCCESS != Cellular_ATRemovePrefix(&pPrefix))
+    /* Handling: +CARECV: 1459,<data>    */
+    if( ( pLine == NULL ) || ( ppDataStart == NULL ) || ( pDataLength == NULL ) ||
+        ( pDataRecv == NULL ) || ( pDataRecv->pContext == NULL ) )
+    {
+        LogError( ( "socketRecvDataPrefix: Bad parameters" ) );
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+    }
+    else
     {
-        CellularLogError("remove prefix(+CARECV) failed: %s", sPrefix);
-        return CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+        *pDataLength = 0;
+        *ppDataStart = NULL;
+        pktStatus = parseRecvDataPrefix( pDataRecv, pLine, lineLength );
     }
 
-    if (CELLULAR_AT_SUCCESS != Cellular_ATGetNextTok(&pPrefix, &pToken))
+    if( pktStatus != CELLULAR_PKT_STATUS_OK )
     {
-        CellularLogError("get recv length failed: %s", sPrefix);
-        return CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+        /* Nothing else to do. */
     }
+    else if( pDataRecv->prefixState == RECV_PREFIX_STATE_PAYLOAD )
+    {
+        pLine[ pDataRecv->prefixOffset - 1U ] = '\0'; /* current line become +CARECV: <len>\0 */
+        pData = &pLine[ pDataRecv->prefixOffset ];
+        *ppDataStart = pData;   /* pktio skips the payload bytes from here    */
+        *pDataLength = pDataRecv->prefixDataLen;
 
-    int32_t nRecvCnt = 0;
+        /* The payload is still in the pktio receive buffer. Copy it to the caller's
+         * buffer now, so _Cellular_RecvFuncData doesn't have to parse the length
+         * again and copy the data out of the response item. */
+        if( ( pDataRecv->pData != NULL ) && ( pDataRecv->pDataLen != NULL ) )
+        {
+            copyLen = pDataRecv->prefixDataLen;
 
-    if (CELLULAR_AT_SUCCESS != Cellular_ATStrtoi(pToken, 10, &nRecvCnt))
-    {
-        CellularLogError("convert recv length failed: %s", pToken);
-        return CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+            if( copyLen > pDataRecv->dataBufSize )
+            {
+                LogError( ( "Data is truncated, received data length %u, out buffer size %u",
+                            copyLen, pDataRecv->dataBufSize ) );
+                copyLen = pDataRecv->dataBufSize;
+            }
+
+            *pDataRecv->pDataLen = copyRecvData( pDataRecv, pData, copyLen );
+            pDataRecv->dataDelivered = true;
+        }
+
+        LogDebug( ( "Data: %p length: %u delivered", pData, pDataRecv->prefixDataLen ) );
     }
+    else if( pDataRecv->prefixState == RECV_PREFIX_STATE_LENGTH )
+    {
+        /* +CARECV: 0. Nothing left on this socket until the next +CADATAIND. */
+        LogDebug( ( "+CARECV: 0 received. no more data" ) );
+        pModuleContext = ( cellularModuleContext_t * ) pDataRecv->pContext->pModueContext;
+        pSocketModuleData = &pModuleContext->socketData[ pDataRecv->socketHandle->socketId ];
+
+        /* The caller holds rxLock, rxRingCount is stable. With data left in the
+         * ring the application hasn't drained the socket, socketRecvFromRing
+         * clears the bit once the ring is empty. */
+        ( void ) xSemaphoreTake( pModuleContext->socketLock, portMAX_DELAY );
+        pSocketModuleData->rxModemData = false;
+
+        if( pSocketModuleData->rxRingCount == 0U )
+        {
+            ( void ) xEventGroupClearBits( pModuleContext->rxDataEvent,
+                                           RX_DATA_EVENT_BIT( pDataRecv->socketHandle->socketId ) );
+        }
 
-    if ((nRecvCnt < 0) || (nRecvCnt > CELLULAR_MAX_RECV_DATA_LEN))
+        ( void ) xSemaphoreGive( pModuleContext->socketLock );
+    }
+    else
     {
-        CellularLogError("Data response received with wrong size: %d", nRecvCnt);
-        return CELLULAR_PKT_STATUS_PREFIX_MISMATCH;
+        /* OK or +CADATAIND in the response. Just ignore. */
     }
 
-    if (lineLength < (uint32_t)(nRecvCnt + pData - pLine)) /*lineLength not enguth */
+    /* Start from a new line next time unless more data is required for this one. */
+    if( ( pDataRecv != NULL ) && ( pktStatus != CELLULAR_PKT_STATUS_SIZE_MISMATCH ) )
     {
-        /* More data is required. */
-        CellularLogDebug("need more data %u < %u", lineLength, (uint32_t)nRecvCnt + pData - pLine);
-        return CELLULAR_PKT_STATUS_SIZE_MISMATCH; /* Modem recv continue*/
+        pDataRecv->prefixState = RECV_PREFIX_STATE_MATCH;
+        pDataRecv->prefixOffset = 0;
+        pDataRecv->prefixLineStart = 0;
+        pDataRecv->prefixDataLen = 0;
     }
 
-    *pDataLength = nRecvCnt;
-    *pData++ = 0;         /* current line become +CARECV: <len>\0       */
-    *ppDataStart = pData; /* pData will be saved to pResp->pItm->next   */
-    CellularLogDebug("Data: %p length: %d saved to nex pResp", pData, nRecvCnt);
-
-    return CELLULAR_PKT_STATUS_OK;
+    return pktStatus;
 }
 
 /*-----------------------------------------------------------*/
@@ -1801,148 +2160,514 @@ static CellularError_t storeAccessModeAndAddress( CellularContext_t * pContext,
 
 /*-----------------------------------------------------------*/
 
-static CellularError_t registerDnsEventCallback( cellularModuleContext_t * pModuleContext,
-                                                 CellularDnsResultEventCallback_t dnsEventCallback,
-                                                 char * pDnsUsrData )
+/* Time to wait for +CDNSGIP after an AT+CDNSGIP with timeoutMs. */
+static uint32_t dnsQueryWaitMs( uint32_t timeoutMs )
 {
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    return ( timeoutMs * ( CELLULAR_SIM70X0_DNS_RETRY_COUNT + 1U ) ) + DNS_QUERY_MARGIN_MS;
+}
 
-    if( pModuleContext == NULL )
-    {
-        cellularStatus = CELLULAR_INVALID_HANDLE;
-    }
-    else
-    {
-        pModuleContext->dnsEventCallback = dnsEventCallback;
-        pModuleContext->pDnsUsrData = pDnsUsrData;
-    }
+/*-----------------------------------------------------------*/
 
-    return cellularStatus;
+static uint32_t dnsNextRequestId( cellularModuleContext_t * pModuleContext )
+{
+    uint32_t requestId = 0;
+
+    PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+    pModuleContext->dnsRequestId++;
+    requestId = pModuleContext->dnsRequestId;
+    PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+
+    return requestId;
 }
 
 /*-----------------------------------------------------------*/
 
-static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
-                                char * pDnsResult,
-                                char * pDnsUsrData )
+/* Claim a query slot, CELLULAR_SIM70X0_DNS_MAX_QUERIES if all are in use.
+ * *pSendQuery is false if an AT+CDNSGIP for the same host and context is in
+ * flight already. The slot then completes with that query. A slot with a
+ * callback keeps its own copy of the hostname. */
+static uint32_t dnsQueryStart( cellularModuleContext_t * pModuleContext,
+                               uint8_t contextId,
+                               const char * pcHostName,
+                               uint32_t waitMs,
+                               CellularDnsCallback_t callback,
+                               void * pUserData,
+                               uint32_t requestId,
+                               bool * pSendQuery )
 {
-    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
-    char * pToken = NULL, * pDnsResultStr = pDnsResult;
-    int32_t dnsResultNumber = 0;
-    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+    cellularDnsQuery_t * pQuery = NULL;
+    const cellularDnsQuery_t * pInFlight = NULL;
+    uint32_t queryIndex = CELLULAR_SIM70X0_DNS_MAX_QUERIES;
+    uint32_t i = 0;
 
-    if( pModuleContext != NULL )
+    PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+
+    for( i = 0; i < CELLULAR_SIM70X0_DNS_MAX_QUERIES; i++ )
     {
-        if( pModuleContext->dnsResultNumber == ( uint8_t ) 0 )
-        {
-            atCoreStatus = Cellular_ATGetNextTok( &pDnsResultStr, &pToken );
+        pQuery = &pModuleContext->dnsQueries[ i ];
 
-            if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        if( pQuery->pcHostName == NULL )
+        {
+            if( queryIndex == CELLULAR_SIM70X0_DNS_MAX_QUERIES )
             {
-                atCoreStatus = Cellular_ATGetNextTok( &pDnsResultStr, &pToken );
+                queryIndex = i;
             }
+        }
+        else if( ( pQuery->done == false ) && ( pQuery->contextId == contextId ) &&
+                 ( strcmp( pQuery->pcHostName, pcHostName ) == 0 ) )
+        {
+            pInFlight = pQuery;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+    }
 
-            if( atCoreStatus == CELLULAR_AT_SUCCESS )
-            {
-                atCoreStatus = Cellular_ATStrtoi( pToken, 10, &dnsResultNumber );
+    if( queryIndex < CELLULAR_SIM70X0_DNS_MAX_QUERIES )
+    {
+        pQuery = &pModuleContext->dnsQueries[ queryIndex ];
+        pQuery->pcHostName = pcHostName;
+        pQuery->dnsResult.addressCount = 0;
+        pQuery->contextId = contextId;
+        pQuery->done = false;
+        pQuery->result = CELLULAR_DNS_QUERY_UNKNOWN;
+        pQuery->startTick = xTaskGetTickCount();
+        pQuery->waitMs = waitMs;
+        pQuery->callback = callback;
+        pQuery->pUserData = pUserData;
+        pQuery->requestId = requestId;
 
-                if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsResultNumber >= 0 ) &&
-                    ( dnsResultNumber <= ( int32_t ) UINT8_MAX ) )
-                {
-                    pModuleContext->dnsResultNumber = ( uint8_t ) dnsResultNumber;
-                }
-                else
-                {
-                    LogDebug( ( "_dnsResultCallback convert string failed %s", pToken ) );
-                }
-            }
+        if( callback != NULL )
+        {
+            ( void ) strncpy( pQuery->hostName, pcHostName, CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN );
+            pQuery->hostName[ CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN ] = '\0';
+            pQuery->pcHostName = pQuery->hostName;
+        }
+
+        /* The sequence is taken before AT+CDNSGIP is sent. The +CDNSGIP URC
+         * can be handled before the OK reaches this task. */
+        if( pInFlight != NULL )
+        {
+            pQuery->sequence = pInFlight->sequence;
+            *pSendQuery = false;
         }
-        else if( ( pModuleContext->dnsIndex < pModuleContext->dnsResultNumber ) && ( pDnsResultStr != NULL ) )
+        else
         {
-            pModuleContext->dnsIndex = pModuleContext->dnsIndex + ( uint8_t ) 1;
+            pModuleContext->dnsQuerySequence++;
+            pQuery->sequence = pModuleContext->dnsQuerySequence;
 
-            ( void ) strncpy( pDnsUsrData, pDnsResultStr, CELLULAR_IP_ADDRESS_MAX_SIZE );
-            ( void ) registerDnsEventCallback( pModuleContext, NULL, NULL );
-            dnsQueryResult = CELLULAR_DNS_QUERY_SUCCESS;
+            /* Keep the latest deadline of the unanswered AT+CDNSGIP. */
+            dnsUnansweredExpire( pModuleContext );
 
-            if( xQueueSend( pModuleContext->pktDnsQueue, &dnsQueryResult, ( TickType_t ) 0 ) != pdPASS )
+            if( ( pModuleContext->dnsUnanswered == 0U ) ||
+                ( pdMS_TO_TICKS( waitMs ) >= ( pdMS_TO_TICKS( pModuleContext->dnsUnansweredWaitMs ) -
+                                               ( pQuery->startTick - pModuleContext->dnsUnansweredTick ) ) ) )
             {
-                LogDebug( ( "_dnsResultCallback sends pktDnsQueue fail" ) );
+                pModuleContext->dnsUnansweredTick = pQuery->startTick;
+                pModuleContext->dnsUnansweredWaitMs = waitMs;
             }
+
+            pModuleContext->dnsUnanswered++;
+            *pSendQuery = true;
         }
-        else
-        {
-            LogDebug( ( "_dnsResultCallback spurious DNS response" ) );
-        }
+
+        ( void ) xEventGroupClearBits( pModuleContext->dnsEvent, DNS_EVENT_BIT( queryIndex ) );
     }
+
+    PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+
+    return queryIndex;
 }
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_SetRatPriority( CellularHandle_t cellularHandle,
-                                         const CellularRat_t * pRatPriorities,
-                                         uint8_t ratPrioritiesLength )
+static CellularError_t dnsQuerySend( CellularContext_t * pContext,
+                                     uint8_t contextId,
+                                     const char * pcHostName,
+                                     uint32_t timeoutMs )
 {
-    UNREFERENCED_PARAMETER(cellularHandle);
-    UNREFERENCED_PARAMETER(pRatPriorities);
-    UNREFERENCED_PARAMETER(ratPrioritiesLength);
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE ];
+    CellularAtReq_t atReqQueryDns =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
 
-    return CELLULAR_PKT_STATUS_OK;
+    /* The return value of snprintf is not used.
+     * The max length of the string is fixed and checked offline. */
+    /* coverity[misra_c_2012_rule_21_6_violation]. */
+    ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE, "AT+CDNSGIP=%u,\"%s\",%u,%u",
+                       pdn2cid(contextId), pcHostName, CELLULAR_SIM70X0_DNS_RETRY_COUNT, timeoutMs );
+    pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQueryDns );
+
+    if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    {
+        LogError( ( "dnsQuerySend: couldn't resolve host name" ) );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    return cellularStatus;
 }
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetRatPriority( CellularHandle_t cellularHandle,
-                                         CellularRat_t * pRatPriorities,
-                                         uint8_t ratPrioritiesLength,
-                                         uint8_t * pReceiveRatPrioritesLength )
+/* Complete and wake every pending slot waiting for the AT+CDNSGIP of sequence.
+ * Called with dnsQueryMutex held. */
+static void dnsQueryFinish( cellularModuleContext_t * pModuleContext,
+                            uint32_t sequence,
+                            cellularDnsQueryResult_t dnsQueryResult,
+                            const cellularDnsResult_t * pDnsResult )
 {
-    UNREFERENCED_PARAMETER(cellularHandle);
-    UNREFERENCED_PARAMETER(pRatPriorities);
-    UNREFERENCED_PARAMETER(ratPrioritiesLength);
-    UNREFERENCED_PARAMETER(pReceiveRatPrioritesLength);
+    cellularDnsQuery_t * pQuery = NULL;
+    uint32_t i = 0;
 
-    return CELLULAR_PKT_STATUS_OK;
+    for( i = 0; i < CELLULAR_SIM70X0_DNS_MAX_QUERIES; i++ )
+    {
+        pQuery = &pModuleContext->dnsQueries[ i ];
+
+        if( ( pQuery->pcHostName != NULL ) && ( pQuery->done == false ) && ( pQuery->sequence == sequence ) )
+        {
+            if( pDnsResult != NULL )
+            {
+                pQuery->dnsResult = *pDnsResult;
+            }
+
+            pQuery->result = dnsQueryResult;
+            pQuery->done = true;
+            ( void ) xEventGroupSetBits( pModuleContext->dnsEvent, DNS_EVENT_BIT( i ) );
+        }
+    }
 }
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_SetDns( CellularHandle_t cellularHandle,
-                                 uint8_t contextId,
-                                 const char * pDnsServerAddress )
+/* Forget the unanswered AT+CDNSGIP once the modem's own timeout of the
+ * latest one has passed. A +CDNSGIP lost on the way, across a modem reset
+ * for instance, would otherwise count forever. Called with dnsQueryMutex held. */
+static void dnsUnansweredExpire( cellularModuleContext_t * pModuleContext )
 {
-    UNREFERENCED_PARAMETER(cellularHandle);
-    UNREFERENCED_PARAMETER(contextId);
-    UNREFERENCED_PARAMETER(pDnsServerAddress);
-
-    return CELLULAR_PKT_STATUS_OK;
+    if( ( pModuleContext->dnsUnanswered > 0U ) &&
+        ( ( xTaskGetTickCount() - pModuleContext->dnsUnansweredTick ) >=
+          pdMS_TO_TICKS( pModuleContext->dnsUnansweredWaitMs ) ) )
+    {
+        LogDebug( ( "dnsUnansweredExpire: %u AT+CDNSGIP never answered", pModuleContext->dnsUnanswered ) );
+        pModuleContext->dnsUnanswered = 0;
+    }
 }
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetPsmSettings( CellularHandle_t cellularHandle,
-                                         CellularPsmSettings_t * pPsmSettings )
+/* AT+CDNSGIP of the slot failed. Slots sharing it complete with an unknown
+ * result and the slot is freed without a callback. */
+static void dnsQueryAbort( cellularModuleContext_t * pModuleContext,
+                           uint32_t queryIndex )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    CellularAtReq_t atReqGetPsm =
+    PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+
+    /* No +CDNSGIP follows a rejected command. */
+    if( pModuleContext->dnsUnanswered > 0U )
     {
-        "AT+CPSMS?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+CPSMS",
-        _Cellular_RecvFuncGetPsmSettings,
-        pPsmSettings,
-        sizeof( CellularPsmSettings_t ),
-    };
+        pModuleContext->dnsUnanswered--;
+    }
+
+    dnsQueryFinish( pModuleContext, pModuleContext->dnsQueries[ queryIndex ].sequence,
+                    CELLULAR_DNS_QUERY_UNKNOWN, NULL );
+    pModuleContext->dnsQueries[ queryIndex ].pcHostName = NULL;
+    PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+
+    ( void ) _Cellular_DnsQueryDispatch( pModuleContext );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Free the slot and copy its addresses. Returns false if it hasn't completed,
+ * a +CDNSGIP arriving later is dropped then. */
+static bool dnsQueryRelease( cellularModuleContext_t * pModuleContext,
+                             uint32_t queryIndex,
+                             cellularDnsQueryResult_t * pDnsQueryResult,
+                             cellularDnsResult_t * pDnsResult )
+{
+    cellularDnsQuery_t * pQuery = &pModuleContext->dnsQueries[ queryIndex ];
+    bool done = false;
+
+    PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+    done = pQuery->done;
+    *pDnsQueryResult = pQuery->result;
+    *pDnsResult = pQuery->dnsResult;
+    pQuery->pcHostName = NULL;
+    PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+
+    return done;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Status of a query. Answers of the modem are cached, timeouts are not. */
+static CellularError_t dnsQueryStatus( cellularModuleContext_t * pModuleContext,
+                                       uint8_t contextId,
+                                       const char * pcHostName,
+                                       bool done,
+                                       cellularDnsQueryResult_t dnsQueryResult,
+                                       const cellularDnsResult_t * pDnsResult )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( done == false )
+    {
+        cellularStatus = CELLULAR_TIMEOUT;
+    }
+    else if( dnsQueryResult == CELLULAR_DNS_QUERY_SUCCESS )
+    {
+        dnsCacheStore( pModuleContext, contextId, pcHostName, pDnsResult );
+    }
+    else if( dnsQueryResult == CELLULAR_DNS_QUERY_FAILED )
+    {
+        /* The name doesn't resolve. */
+        dnsCacheStore( pModuleContext, contextId, pcHostName, NULL );
+        cellularStatus = CELLULAR_UNKNOWN;
+    }
+    else
+    {
+        /* The shared AT+CDNSGIP couldn't be sent, or it may have failed for
+         * another query. Not cached, the name may well resolve. */
+        cellularStatus = CELLULAR_UNKNOWN;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called by the +CDNSGIP handler. The modem answers in send order, so the
+ * oldest pending query for pHostName completes with pDnsResult. Its sequence
+ * also fixes the context, +CDNSGIP doesn't name one.
+ *
+ * The error form, pHostName NULL, doesn't name the host either. It fails the
+ * oldest pending query as a name that doesn't resolve only if no other
+ * AT+CDNSGIP is unanswered, a timed out one included. Otherwise the error may
+ * belong to another query and the oldest one completes as unknown, which
+ * isn't cached. */
+bool _Cellular_DnsQueryComplete( cellularModuleContext_t * pModuleContext,
+                                 const char * pHostName,
+                                 const cellularDnsResult_t * pDnsResult )
+{
+    const cellularDnsQuery_t * pQuery = NULL;
+    const cellularDnsQuery_t * pOldest = NULL;
+    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_SUCCESS;
+    uint32_t unanswered = 0;
+    uint32_t i = 0;
+
+    PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+
+    dnsUnansweredExpire( pModuleContext );
+    unanswered = pModuleContext->dnsUnanswered;
+
+    if( pModuleContext->dnsUnanswered > 0U )
+    {
+        pModuleContext->dnsUnanswered--;
+    }
+
+    for( i = 0; i < CELLULAR_SIM70X0_DNS_MAX_QUERIES; i++ )
+    {
+        pQuery = &pModuleContext->dnsQueries[ i ];
+
+        if( ( pQuery->pcHostName != NULL ) && ( pQuery->done == false ) &&
+            ( ( pHostName == NULL ) || ( strcmp( pQuery->pcHostName, pHostName ) == 0 ) ) &&
+            ( ( pOldest == NULL ) || ( ( int32_t ) ( pQuery->sequence - pOldest->sequence ) < 0 ) ) )
+        {
+            pOldest = pQuery;
+        }
+    }
+
+    if( pDnsResult == NULL )
+    {
+        dnsQueryResult = ( unanswered <= 1U ) ? CELLULAR_DNS_QUERY_FAILED : CELLULAR_DNS_QUERY_UNKNOWN;
+    }
+
+    if( pOldest != NULL )
+    {
+        dnsQueryFinish( pModuleContext, pOldest->sequence, dnsQueryResult, pDnsResult );
+    }
+    else
+    {
+        LogDebug( ( "_Cellular_DnsQueryComplete: no query for %s", ( pHostName != NULL ) ? pHostName : "error" ) );
+    }
+
+    PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+
+    /* Asynchronous queries get their callback in the URC context. */
+    ( void ) _Cellular_DnsQueryDispatch( pModuleContext );
+
+    return ( pOldest != NULL );
+}
+
+/*-----------------------------------------------------------*/
+
+/* The modem was reset or powered down. No +CDNSGIP follows for the queries
+ * sent before, they complete as unknown and nothing is cached. */
+void _Cellular_DnsQueryReset( cellularModuleContext_t * pModuleContext )
+{
+    const cellularDnsQuery_t * pQuery = NULL;
+    uint32_t i = 0;
+
+    if( pModuleContext != NULL )
+    {
+        PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+
+        pModuleContext->dnsUnanswered = 0;
+
+        for( i = 0; i < CELLULAR_SIM70X0_DNS_MAX_QUERIES; i++ )
+        {
+            pQuery = &pModuleContext->dnsQueries[ i ];
+
+            if( ( pQuery->pcHostName != NULL ) && ( pQuery->done == false ) )
+            {
+                dnsQueryFinish( pModuleContext, pQuery->sequence, CELLULAR_DNS_QUERY_UNKNOWN, NULL );
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+
+        ( void ) _Cellular_DnsQueryDispatch( pModuleContext );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Run the callback of every completed or timed out asynchronous query and
+ * free its slot. The callbacks run without dnsQueryMutex. Returns the ticks
+ * until the next asynchronous query times out. */
+TickType_t _Cellular_DnsQueryDispatch( cellularModuleContext_t * pModuleContext )
+{
+    cellularDnsQuery_t * pQuery = NULL;
+    cellularDnsQuery_t query;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    TickType_t waitTicks = portMAX_DELAY;
+    TickType_t elapsedTicks = 0;
+    TickType_t timeoutTicks = 0;
+    bool found = true;
+    uint32_t i = 0;
+
+    while( found == true )
+    {
+        found = false;
+        waitTicks = portMAX_DELAY;
+        PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+
+        for( i = 0; ( found == false ) && ( i < CELLULAR_SIM70X0_DNS_MAX_QUERIES ); i++ )
+        {
+            pQuery = &pModuleContext->dnsQueries[ i ];
+
+            if( ( pQuery->pcHostName != NULL ) && ( pQuery->callback != NULL ) )
+            {
+                elapsedTicks = xTaskGetTickCount() - pQuery->startTick;
+                timeoutTicks = pdMS_TO_TICKS( pQuery->waitMs );
+
+                if( ( pQuery->done == true ) || ( elapsedTicks >= timeoutTicks ) )
+                {
+                    /* The copy keeps the hostname once the slot is reused. */
+                    query = *pQuery;
+                    pQuery->pcHostName = NULL;
+                    found = true;
+                }
+                else if( ( timeoutTicks - elapsedTicks ) < waitTicks )
+                {
+                    waitTicks = timeoutTicks - elapsedTicks;
+                }
+                else
+                {
+                    /* Empty else MISRA 15.7 */
+                }
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+
+        if( found == true )
+        {
+            cellularStatus = dnsQueryStatus( pModuleContext, query.contextId, query.hostName,
+                                             query.done, query.result, &query.dnsResult );
+            query.callback( query.requestId, query.hostName, cellularStatus,
+                            ( cellularStatus == CELLULAR_SUCCESS ) ? &query.dnsResult : NULL, query.pUserData );
+        }
+    }
+
+    return waitTicks;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SetRatPriority( CellularHandle_t cellularHandle,
+                                         const CellularRat_t * pRatPriorities,
+                                         uint8_t ratPrioritiesLength )
+{
+    UNREFERENCED_PARAMETER(cellularHandle);
+    UNREFERENCED_PARAMETER(pRatPriorities);
+    UNREFERENCED_PARAMETER(ratPrioritiesLength);
+
+    return CELLULAR_PKT_STATUS_OK;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetRatPriority( CellularHandle_t cellularHandle,
+                                         CellularRat_t * pRatPriorities,
+                                         uint8_t ratPrioritiesLength,
+                                         uint8_t * pReceiveRatPrioritesLength )
+{
+    UNREFERENCED_PARAMETER(cellularHandle);
+    UNREFERENCED_PARAMETER(pRatPriorities);
+    UNREFERENCED_PARAMETER(ratPrioritiesLength);
+    UNREFERENCED_PARAMETER(pReceiveRatPrioritesLength);
+
+    return CELLULAR_PKT_STATUS_OK;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SetDns( CellularHandle_t cellularHandle,
+                                 uint8_t contextId,
+                                 const char * pDnsServerAddress )
+{
+    UNREFERENCED_PARAMETER(cellularHandle);
+    UNREFERENCED_PARAMETER(contextId);
+    UNREFERENCED_PARAMETER(pDnsServerAddress);
+
+    return CELLULAR_PKT_STATUS_OK;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetPsmSettings( CellularHandle_t cellularHandle,
+                                         CellularPsmSettings_t * pPsmSettings )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularAtReq_t atReqGetPsm =
+    {
+        "AT+CPSMS?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CPSMS",
+        _Cellular_RecvFuncGetPsmSettings,
+        pPsmSettings,
+        sizeof( CellularPsmSettings_t ),
+    };
 
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
@@ -2124,6 +2849,7 @@ CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
     char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularModuleContext_t * pModuleContext = NULL;
     CellularAtReq_t atReqDeactPdn =
     {
         cmdBuf,
@@ -2157,6 +2883,14 @@ CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
             LogError( ( "Cellular_DeactivatePdn: can't deactivate PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
             cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
         }
+        else if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            _Cellular_PdnStateUpdate( pModuleContext, ( uint8_t ) pdn2cid( contextId ), false );
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
     }
 
     return cellularStatus;
@@ -2164,16 +2898,34 @@ CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
-                                      uint8_t contextId )
+/* CID of contextId if it has an entry in pdnContexts. */
+static bool pdnContextCid( uint8_t contextId,
+                           uint8_t * pCid )
+{
+    bool valid = false;
+
+    if( ( _Cellular_IsValidPdn( contextId ) == CELLULAR_SUCCESS ) && ( pdn2cid( contextId ) <= CELLULAR_CID_MAX ) )
+    {
+        *pCid = ( uint8_t ) pdn2cid( contextId );
+        valid = true;
+    }
+
+    return valid;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Send AT+CNCFG with the configuration stored for the CID, then AT+CNACT.
+ * +APP PDP reports the result and sets PDN_EVENT_BIT of the CID. */
+static CellularError_t pdnActivateStart( CellularContext_t * pContext,
+                                         cellularModuleContext_t * pModuleContext,
+                                         uint8_t cid )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE] = { '\0' };
-
+    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+    const CellularPdnConfig_t * pPdnCfg = &pModuleContext->pdnContexts[ cid ].config;
+    bool configured = false;
     CellularAtReq_t atReqActPdn =
     {
         cmdBuf,
@@ -2183,32 +2935,34 @@ CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
         NULL,
         0,
     };
-    cellularModuleContext_t*    pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
-    const CellularPdnConfig_t*  pPdnCfg = pSimContex->pPdnCfg;
-
-    cellularStatus = _Cellular_IsValidPdn( contextId );
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        /* Make sure the library is open. */
-        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
-    }
+    /* Cellular_SetPdnConfig writes the config with pdnLock held. */
+    ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+    configured = pModuleContext->pdnContexts[ cid ].configured;
 
-    if (cellularStatus == CELLULAR_SUCCESS)
+    if( configured == true )
     {
-        if (pPdnCfg->password && strlen(pPdnCfg->password) > 0
-            && pPdnCfg->username && strlen(pPdnCfg->username) > 0
-            && pPdnCfg->pdnAuthType > 0)
+        if ((strlen(pPdnCfg->password) > 0) && (strlen(pPdnCfg->username) > 0) && (pPdnCfg->pdnAuthType > 0))
             (void)snprintf(cmdBuf, sizeof(cmdBuf), "AT+CNCFG=%d,%d,\"%s\",\"%s\",\"%s\",%d",
-                pdn2cid(contextId),
+                cid,
                 0,      /* 0=Dual Stack, 1=IPV4, 2=IPV6*/
                 pPdnCfg->apnName, pPdnCfg->username, pPdnCfg->password, pPdnCfg->pdnAuthType);
         else
             (void)snprintf(cmdBuf, sizeof(cmdBuf), "AT+CNCFG=%d,%d,\"%s\"",
-                pdn2cid(contextId),
+                cid,
                 0,      /* 0=Dual Stack, 1=IPV4, 2=IPV6*/
                 pPdnCfg->apnName);
+    }
 
+    ( void ) xSemaphoreGive( pModuleContext->pdnLock );
+
+    if( configured == false )
+    {
+        /* Activate with what the modem has stored for the CID. */
+        LogDebug( ( "pdnActivateStart: no PDN config for CID %u", cid ) );
+    }
+    else
+    {
         CellularLogInfo("cmd:%s", cmdBuf);
         pktStatus = _Cellular_AtcmdRequestWithCallback(pContext, atReqActPdn);
 
@@ -2221,23 +2975,16 @@ CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        xEventGroupClearBits(pSimContex->pdnEvent, EVENT_BIT_PDN_ACT);
+        xEventGroupClearBits(pModuleContext->pdnEvent, EVENT_BIT_PDN_ACT | PDN_EVENT_BIT(cid));
 
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "AT+CNACT=%d,1", pdn2cid(contextId) );
+        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "AT+CNACT=%d,1", cid );
         pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqActPdn, PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS );
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
-            LogError( ( "Cellular_ActivatePdn: can't activate PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+            LogError( ( "pdnActivateStart: can't activate PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
             cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
         }
-#if 0
-        else
-        {
-            xEventGroupWaitBits(pSimContex->pdnEvent, EVENT_BIT_PDN_ACT, true, false,
-                pdMS_TO_TICKS(PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS));
-        }
-#endif
     }
 
     return cellularStatus;
@@ -2247,94 +2994,52 @@ CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
 
 /* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_SetPdnConfig( CellularHandle_t cellularHandle,
-                                       uint8_t contextId,
-                                       const CellularPdnConfig_t * pPdnConfig )
+CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
+                                      uint8_t contextId )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSetPdn =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint8_t cid = 0;
 
-    if( pPdnConfig == NULL )
+    if( pdnContextCid( contextId, &cid ) == false )
     {
-        LogError( ( "Cellular_ATCommandRaw: Input parameter is NULL" ) );
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
-
-    if( cellularStatus == CELLULAR_SUCCESS )
+    else
     {
-        cellularStatus = _Cellular_IsValidPdn( contextId );
+        /* Make sure the library is open. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* Make sure the library is open. */
-        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
+        cellularStatus = pdnActivateStart( pContext, pModuleContext, cid );
+    }
 
-        (void)snprintf(cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "AT+CGDCONT=%d,\"%s\",\"%s\"",
-            contextId,
-            pPdnConfig->pdnContextType == CELLULAR_PDN_CONTEXT_IPV6 ? "IPV6" :
-            pPdnConfig->pdnContextType == CELLULAR_PDN_CONTEXT_IPV4 ? "IP" : "IPV4V6",
-            pPdnConfig->apnName);
-        pktStatus = _Cellular_AtcmdRequestWithCallback(pContext, atReqSetPdn);
-
-        if (pPdnConfig->pdnAuthType == 0)
-            (void)snprintf(cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "AT+CGAUTH=%d,0", contextId);
-        else
-            (void)snprintf(cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "AT+CGAUTH=%d,%d,\"%s\",\"%s\"",
-                contextId,
-                pPdnConfig->pdnAuthType,
-                pPdnConfig->password,
-                pPdnConfig->username);
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetPdn );
-
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
-        {
-            LogError( ( "Cellular_SetPdnConfig: can't set PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-        }
-
-        cellularModuleContext_t* pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
-        pSimContex->pPdnCfg = pPdnConfig;
-    }
-
-    return cellularStatus;
-}
+    return cellularStatus;
+}
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
-                                        CellularSignalInfo_t * pSignalInfo )
+CellularError_t Cellular_ActivatePdnMulti( CellularHandle_t cellularHandle,
+                                           const uint8_t * pContextIds,
+                                           uint8_t numContexts,
+                                           CellularError_t * pStatuses )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    CellularRat_t rat = CELLULAR_RAT_INVALID;
-    CellularAtReq_t atReqQuerySignalInfo =
-    {
-        "AT+CPSI?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+CPSI:",
-        _Cellular_RecvFuncGetSignalInfo,
-        pSignalInfo,
-        sizeof( CellularSignalInfo_t ),
-    };
+    cellularModuleContext_t * pModuleContext = NULL;
+    EventBits_t waitBits = 0;
+    EventBits_t eventBits = 0;
+    uint8_t cid = 0;
+    uint8_t i = 0;
 
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
@@ -2342,26 +3047,77 @@ CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pSignalInfo == NULL )
+    else if( ( pContextIds == NULL ) || ( numContexts == 0U ) || ( pStatuses == NULL ) )
     {
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        cellularStatus = _Cellular_GetCurrentRat( pContext, &rat );
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    /* Start every activation before waiting for any of them. */
+    for( i = 0; ( cellularStatus == CELLULAR_SUCCESS ) && ( i < numContexts ); i++ )
+    {
+        if( pdnContextCid( pContextIds[ i ], &cid ) == false )
+        {
+            pStatuses[ i ] = CELLULAR_BAD_PARAMETER;
+        }
+        else
+        {
+            pStatuses[ i ] = pdnActivateStart( pContext, pModuleContext, cid );
+        }
+
+        if( pStatuses[ i ] == CELLULAR_SUCCESS )
+        {
+            waitBits = waitBits | PDN_EVENT_BIT( cid );
+        }
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( waitBits != 0U ) )
+    {
+        eventBits = xEventGroupWaitBits( pModuleContext->pdnEvent, waitBits, pdTRUE, pdTRUE,
+                                         pdMS_TO_TICKS( PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS ) );
     }
 
+    /* The URC handler updates active with pdnLock held. */
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQuerySignalInfo );
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+    }
 
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+    for( i = 0; ( cellularStatus == CELLULAR_SUCCESS ) && ( i < numContexts ); i++ )
+    {
+        if( pStatuses[ i ] != CELLULAR_SUCCESS )
         {
-            /* If the convert failed, the API will return CELLULAR_INVALID_SIGNAL_BAR_VALUE in bars field. */
-            ( void ) _Cellular_ComputeSignalBars( rat, pSignalInfo );
+            /* Not started. */
+        }
+        else if( ( eventBits & PDN_EVENT_BIT( pdn2cid( pContextIds[ i ] ) ) ) == 0U )
+        {
+            pStatuses[ i ] = CELLULAR_TIMEOUT;
+        }
+        else if( pModuleContext->pdnContexts[ pdn2cid( pContextIds[ i ] ) ].active == false )
+        {
+            pStatuses[ i ] = CELLULAR_UNKNOWN;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
         }
+    }
 
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
+    }
+
+    for( i = 0; ( cellularStatus == CELLULAR_SUCCESS ) && ( i < numContexts ); i++ )
+    {
+        if( pStatuses[ i ] != CELLULAR_SUCCESS )
+        {
+            LogError( ( "Cellular_ActivatePdnMulti: context %u failed %d", pContextIds[ i ], pStatuses[ i ] ) );
+            cellularStatus = pStatuses[ i ];
+        }
     }
 
     return cellularStatus;
@@ -2369,169 +3125,299 @@ CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
-/* coverity[misra_c_2012_rule_8_7_violation] */
-/* coverity[misra_c_2012_rule_8_13_violation] */
-CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
-                                     CellularSocketHandle_t socketHandle,
-                                     /* coverity[misra_c_2012_rule_8_13_violation] */
-                                     uint8_t * pBuffer,
-                                     uint32_t bufferLength,
-                                     /* coverity[misra_c_2012_rule_8_13_violation] */
-                                     uint32_t * pReceivedDataLength )
+/* Read AT+CNACT? into the state cache of every CID. */
+static CellularError_t pdnStateRefresh( CellularContext_t * pContext,
+                                        cellularModuleContext_t * pModuleContext )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    uint32_t recvTimeout = DATA_READ_TIMEOUT_MS;
-    uint32_t recvLen = bufferLength;
-    _socketDataRecv_t dataRecv =
+    CellularPdnStatus_t pdnStatusBuffers[ CELLULAR_CID_MAX + 1 ];
+    cellularPdnContext_t * pPdnContext = NULL;
+    TickType_t nowTick = 0;
+    uint8_t i = 0;
+    CellularAtReq_t atReqGetPdnStatus =
     {
-        pReceivedDataLength,
-        pBuffer,
-        NULL
+        "AT+CNACT?",
+        CELLULAR_AT_MULTI_WITH_PREFIX,
+        "+CNACT",
+        _Cellular_RecvFuncGetPdnStatus,
+        pdnStatusBuffers,
+        CELLULAR_CID_MAX + 1,
     };
-    CellularAtReq_t atReqSocketRecv =
+
+    ( void ) memset( pdnStatusBuffers, 0, sizeof( pdnStatusBuffers ) );
+
+    for( i = 0; i <= CELLULAR_CID_MAX; i++ )
     {
-        cmdBuf,
-        CELLULAR_AT_MULTI_DATA_WO_PREFIX,
-        "+CARECV",
-        _Cellular_RecvFuncData,
-        ( void * ) &dataRecv,
-        bufferLength,
-    };
+        /* +CNACT has no context type. Any type lets getPdnStatusParseToken take the address. */
+        pdnStatusBuffers[ i ].contextId = INVALID_PDN_INDEX;
+        pdnStatusBuffers[ i ].pdnContextType = CELLULAR_PDN_CONTEXT_IPV4;
+    }
 
-    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetPdnStatus );
+    cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
 
-    if( cellularStatus != CELLULAR_SUCCESS )
+    if( cellularStatus == CELLULAR_SUCCESS )
     {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+        nowTick = xTaskGetTickCount();
+
+        for( i = 0; ( i <= CELLULAR_CID_MAX ) && ( pdnStatusBuffers[ i ].contextId != INVALID_PDN_INDEX ); i++ )
+        {
+            if( pdn2cid( pdnStatusBuffers[ i ].contextId ) <= CELLULAR_CID_MAX )
+            {
+                pPdnContext = &pModuleContext->pdnContexts[ pdn2cid( pdnStatusBuffers[ i ].contextId ) ];
+                pPdnContext->active = ( pdnStatusBuffers[ i ].state == 1U );
+                ( void ) strncpy( pPdnContext->ipAddress, pdnStatusBuffers[ i ].ipAddress.ipAddress,
+                                  CELLULAR_IP_ADDRESS_MAX_SIZE );
+                pPdnContext->ipAddress[ CELLULAR_IP_ADDRESS_MAX_SIZE ] = '\0';
+                pPdnContext->stateKnown = true;
+                pPdnContext->addressKnown = true;
+                pPdnContext->stateTick = nowTick;
+            }
+        }
+
+        pModuleContext->pdnStateRefreshed = true;
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
     }
-    else if( socketHandle == NULL )
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Address of the CID from AT+CNACT?. CELLULAR_UNKNOWN if it isn't active. */
+static CellularError_t pdnReadAddress( CellularContext_t * pContext,
+                                       cellularModuleContext_t * pModuleContext,
+                                       uint8_t cid,
+                                       char * pIpAddress )
+{
+    CellularError_t cellularStatus = pdnStateRefresh( pContext, pModuleContext );
+    const cellularPdnContext_t * pPdnContext = &pModuleContext->pdnContexts[ cid ];
+
+    if( cellularStatus == CELLULAR_SUCCESS )
     {
-        cellularStatus = CELLULAR_INVALID_HANDLE;
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+
+        if( ( pPdnContext->active == true ) && ( pPdnContext->addressKnown == true ) )
+        {
+            ( void ) strncpy( pIpAddress, pPdnContext->ipAddress, CELLULAR_IP_ADDRESS_MAX_SIZE + 1U );
+        }
+        else
+        {
+            cellularStatus = CELLULAR_UNKNOWN;
+        }
+
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
     }
-    else if( ( pBuffer == NULL ) || ( pReceivedDataLength == NULL ) || ( bufferLength == 0U ) )
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Record a state reported by a URC or a command result. The address of an
+ * activated context is read by the next AT+CNACT?. */
+void _Cellular_PdnStateUpdate( cellularModuleContext_t * pModuleContext,
+                               uint8_t cid,
+                               bool active )
+{
+    cellularPdnContext_t * pPdnContext = NULL;
+
+    if( ( pModuleContext != NULL ) && ( cid <= CELLULAR_CID_MAX ) )
     {
-        LogError( ( "_Cellular_RecvData: Bad input Param" ) );
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        pPdnContext = &pModuleContext->pdnContexts[ cid ];
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+        pPdnContext->active = active;
+        pPdnContext->stateKnown = true;
+        pPdnContext->addressKnown = ( active == false );
+        pPdnContext->ipAddress[ 0 ] = '\0';
+        pPdnContext->stateTick = xTaskGetTickCount();
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
     }
-    else
+}
+
+/*-----------------------------------------------------------*/
+
+/* The modem restarted or powered down. Its contexts are gone, the next
+ * Cellular_GetPdnStatus reads them again. */
+void _Cellular_PdnStateInvalidate( cellularModuleContext_t * pModuleContext )
+{
+    uint8_t cid = 0;
+
+    if( pModuleContext != NULL )
     {
-        /* Update recvLen to maximum module length. */
-        if( CELLULAR_MAX_RECV_DATA_LEN <= bufferLength )
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+
+        for( cid = 0; cid <= CELLULAR_CID_MAX; cid++ )
         {
-            recvLen = ( uint32_t ) CELLULAR_MAX_RECV_DATA_LEN;
+            pModuleContext->pdnContexts[ cid ].active = false;
+            pModuleContext->pdnContexts[ cid ].stateKnown = false;
+            pModuleContext->pdnContexts[ cid ].addressKnown = false;
+            pModuleContext->pdnContexts[ cid ].ipAddress[ 0 ] = '\0';
         }
 
-        /* Update receive timeout to default timeout if not set with setsocketopt. */
-        if( socketHandle->recvTimeoutMs != 0U )
+        pModuleContext->pdnStateRefreshed = false;
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Run the callback of every Cellular_ActivatePdnAsync request which got its
+ * +APP PDP or timed out. The callbacks run without pdnLock. Returns the ticks
+ * until the next request times out. */
+TickType_t _Cellular_PdnActivateDispatch( cellularModuleContext_t * pModuleContext )
+{
+    cellularPdnContext_t * pPdnContext = NULL;
+    CellularContext_t * pContext = NULL;
+    CellularPdnActivateCallback_t callback = NULL;
+    void * pUserData = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    char ipAddress[ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ] = { '\0' };
+    const TickType_t timeoutTicks = pdMS_TO_TICKS( PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS );
+    TickType_t waitTicks = portMAX_DELAY;
+    TickType_t elapsedTicks = 0;
+    TickType_t latencyTicks = 0;
+    uint8_t cid = 0;
+    uint8_t foundCid = 0;
+    bool found = true;
+
+    while( found == true )
+    {
+        found = false;
+        waitTicks = portMAX_DELAY;
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+
+        for( cid = 0; ( found == false ) && ( cid <= CELLULAR_CID_MAX ); cid++ )
         {
-            recvTimeout = socketHandle->recvTimeoutMs;
-        }
+            pPdnContext = &pModuleContext->pdnContexts[ cid ];
 
-        cellularModuleContext_t* pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
-        xEventGroupWaitBits(pSimContex->pdnEvent, EVENT_BIT_RX_DATA, false, false,
-            pdMS_TO_TICKS(PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS));
+            if( pPdnContext->activating == true )
+            {
+                elapsedTicks = xTaskGetTickCount() - pPdnContext->activateTick;
+
+                if( ( pPdnContext->reported == true ) || ( elapsedTicks >= timeoutTicks ) )
+                {
+                    if( pPdnContext->reported == false )
+                    {
+                        cellularStatus = CELLULAR_TIMEOUT;
+                        latencyTicks = elapsedTicks;
+                    }
+                    else
+                    {
+                        cellularStatus = ( pPdnContext->active == true ) ? CELLULAR_SUCCESS : CELLULAR_UNKNOWN;
+                        latencyTicks = pPdnContext->reportTick - pPdnContext->activateTick;
+                    }
+
+                    pContext = pPdnContext->pContext;
+                    callback = pPdnContext->activateCallback;
+                    pUserData = pPdnContext->pActivateUserData;
+                    pPdnContext->activating = false;
+                    foundCid = cid;
+                    found = true;
+                }
+                else if( ( timeoutTicks - elapsedTicks ) < waitTicks )
+                {
+                    waitTicks = timeoutTicks - elapsedTicks;
+                }
+                else
+                {
+                    /* Empty else MISRA 15.7 */
+                }
+            }
+        }
 
-        (void)snprintf(cmdBuf, sizeof(cmdBuf),
-            "AT+CARECV=%ld,%ld", socketHandle->socketId, recvLen);
-        pktStatus = _Cellular_TimeoutAtcmdDataRecvRequestWithCallback( pContext,
-                                                                       atReqSocketRecv, recvTimeout, socketRecvDataPrefix, pContext);
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        if( found == true )
         {
-            /* Reset data handling parameters. */
-            LogError( ( "_Cellular_RecvData: Data Receive fail, pktStatus: %d", pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            if( ( cellularStatus == CELLULAR_SUCCESS ) &&
+                ( pdnReadAddress( pContext, pModuleContext, foundCid, ipAddress ) != CELLULAR_SUCCESS ) )
+            {
+                LogWarn( ( "_Cellular_PdnActivateDispatch: no address for CID %u", foundCid ) );
+                ipAddress[ 0 ] = '\0';
+            }
+
+            callback( ( uint8_t ) cid2pdn( foundCid ), cellularStatus,
+                      ( ( cellularStatus == CELLULAR_SUCCESS ) && ( ipAddress[ 0 ] != '\0' ) ) ? ipAddress : NULL,
+                      ( uint32_t ) latencyTicks * ( uint32_t ) portTICK_PERIOD_MS, pUserData );
         }
     }
 
-    return cellularStatus;
+    return waitTicks;
 }
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-/* coverity[misra_c_2012_rule_8_13_violation] */
-CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
-                                     CellularSocketHandle_t socketHandle,
-                                     const uint8_t * pData,
-                                     uint32_t dataLength,
-                                     /* coverity[misra_c_2012_rule_8_13_violation] */
-                                     uint32_t * pSentDataLength )
+CellularError_t Cellular_ActivatePdnAsync( CellularHandle_t cellularHandle,
+                                           uint8_t contextId,
+                                           CellularPdnActivateCallback_t callback,
+                                           void * pUserData )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    uint32_t sendTimeout = DATA_SEND_TIMEOUT_MS;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSocketSend =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
-    CellularAtDataReq_t atDataReqSocketSend =
-    {
-        pData,
-        dataLength,
-        pSentDataLength,
-        NULL,
-        0
-    };
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularPdnContext_t * pPdnContext = NULL;
+    const cellularWorkerJob_t job = { WORKER_JOB_PDN_TIMER, NULL, 0, NULL };
+    uint8_t cid = 0;
 
-    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( socketHandle == NULL )
-    {
-        cellularStatus = CELLULAR_INVALID_HANDLE;
-    }
-    else if( ( pData == NULL ) || ( pSentDataLength == NULL ) || ( dataLength == 0U ) )
+    else if( ( callback == NULL ) || ( pdnContextCid( contextId, &cid ) == false ) )
     {
-        LogError( ( "Cellular_SocketSend: Invalid parameter" ) );
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        /* Send data length check. */
-        if( dataLength > ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN )
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pPdnContext = &pModuleContext->pdnContexts[ cid ];
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+
+        if( pPdnContext->activating == true )
         {
-            atDataReqSocketSend.dataLen = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
+            cellularStatus = CELLULAR_NOT_ALLOWED;
         }
-
-        /* Check send timeout. If not set by setsockopt, use default value. */
-        if( socketHandle->sendTimeoutMs != 0U )
+        else
         {
-            sendTimeout = socketHandle->sendTimeoutMs;
+            /* Armed before AT+CNACT. +APP PDP may arrive before its OK. */
+            pPdnContext->activating = true;
+            pPdnContext->reported = false;
+            pPdnContext->activateTick = xTaskGetTickCount();
+            pPdnContext->pContext = pContext;
+            pPdnContext->activateCallback = callback;
+            pPdnContext->pActivateUserData = pUserData;
         }
 
-        /* Form the AT command. */
-
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        /* coverity[misra_c_2012_rule_21_6_violation]. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "AT+CASEND=%ld,%ld",
-                           socketHandle->socketId, atDataReqSocketSend.dataLen );
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
+    }
 
-        pktStatus = _Cellular_AtcmdDataSend( pContext, atReqSocketSend, atDataReqSocketSend,
-                                             socketSendDataPrefix, NULL,
-                                             PACKET_REQ_TIMEOUT_MS, sendTimeout, 0U );
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = pdnActivateStart( pContext, pModuleContext, cid );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        if( cellularStatus != CELLULAR_SUCCESS )
         {
-            LogError( ( "Cellular_SocketSend: Data send fail, PktRet: %d", pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+            pPdnContext->activating = false;
+            ( void ) xSemaphoreGive( pModuleContext->pdnLock );
+        }
+        else if( _Cellular_PostWorkerJob( pModuleContext, &job ) == false )
+        {
+            LogWarn( ( "Cellular_ActivatePdnAsync: worker busy, timeout of context %u may be late", contextId ) );
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
         }
     }
 
@@ -2542,57 +3428,2602 @@ CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
 
 /* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
-                                      CellularSocketHandle_t socketHandle )
+CellularError_t Cellular_SetPdnConfig( CellularHandle_t cellularHandle,
+                                       uint8_t contextId,
+                                       const CellularPdnConfig_t * pPdnConfig )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSockClose =
+    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+    char authCmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+    uint8_t cid = 0;
+    cellularAtBatchCmd_t pdnCmds[ 2 ] =
     {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
+        { cmdBuf, CELLULAR_SUCCESS },
+        { authCmdBuf, CELLULAR_SUCCESS }
     };
 
-    /* Make sure the library is open. */
-    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
-
-    if( cellularStatus != CELLULAR_SUCCESS )
+    if( pPdnConfig == NULL )
     {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+        LogError( ( "Cellular_ATCommandRaw: Input parameter is NULL" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( pdnContextCid( contextId, &cid ) == false ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Make sure the library is open. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+
+        (void)snprintf(cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "AT+CGDCONT=%d,\"%s\",\"%s\"",
+            contextId,
+            pPdnConfig->pdnContextType == CELLULAR_PDN_CONTEXT_IPV6 ? "IPV6" :
+            pPdnConfig->pdnContextType == CELLULAR_PDN_CONTEXT_IPV4 ? "IP" : "IPV4V6",
+            pPdnConfig->apnName);
+
+        if (pPdnConfig->pdnAuthType == 0)
+            (void)snprintf(authCmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "AT+CGAUTH=%d,0", contextId);
+        else
+            (void)snprintf(authCmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "AT+CGAUTH=%d,%d,\"%s\",\"%s\"",
+                contextId,
+                pPdnConfig->pdnAuthType,
+                pPdnConfig->password,
+                pPdnConfig->username);
+
+        /* One line for both when they fit. */
+        cellularStatus = _Cellular_AtBatchSend( pContext, pdnCmds, 2U, PDN_CONFIG_CMD_TIMEOUT_MS, 1U );
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            LogError( ( "Cellular_SetPdnConfig: can't set PDN, CGDCONT: %d, CGAUTH: %d",
+                        pdnCmds[ 0 ].status, pdnCmds[ 1 ].status ) );
+        }
+
+        /* Kept by copy for the AT+CNCFG of Cellular_ActivatePdn. */
+        cellularModuleContext_t* pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
+        ( void ) xSemaphoreTake( pSimContex->pdnLock, portMAX_DELAY );
+        pSimContex->pdnContexts[ cid ].config = *pPdnConfig;
+        pSimContex->pdnContexts[ cid ].configured = true;
+        ( void ) xSemaphoreGive( pSimContex->pdnLock );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
+                                        CellularSignalInfo_t * pSignalInfo )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularRat_t rat = CELLULAR_RAT_INVALID;
+    CellularAtReq_t atReqQuerySignalInfo =
+    {
+        "AT+CPSI?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CPSI:",
+        _Cellular_RecvFuncGetSignalInfo,
+        pSignalInfo,
+        sizeof( CellularSignalInfo_t ),
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSignalInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetCurrentRat( pContext, &rat );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQuerySignalInfo );
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            /* If the convert failed, the API will return CELLULAR_INVALID_SIGNAL_BAR_VALUE in bars field. */
+            ( void ) _Cellular_ComputeSignalBars( rat, pSignalInfo );
+        }
+
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t remainingTimeMs( TickType_t startTick,
+                                 uint32_t timeoutMs )
+{
+    uint32_t elapsedMs = ( uint32_t ) ( xTaskGetTickCount() - startTick ) * ( uint32_t ) portTICK_PERIOD_MS;
+
+    return ( elapsedMs < timeoutMs ) ? ( timeoutMs - elapsedMs ) : 0U;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t ioVecLength( const cellularSocketIoVec_t * pIoVec,
+                             uint32_t ioVecCount )
+{
+    uint32_t totalLength = 0;
+    uint32_t i = 0;
+
+    for( i = 0; i < ioVecCount; i++ )
+    {
+        totalLength = totalLength + pIoVec[ i ].bufferLength;
+    }
+
+    return totalLength;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t socketRecvData( CellularContext_t * pContext,
+                                       CellularSocketHandle_t socketHandle,
+                                       uint8_t * pBuffer,
+                                       uint32_t bufferLength,
+                                       uint32_t recvTimeout,
+                                       uint32_t * pReceivedDataLength )
+{
+    const cellularSocketIoVec_t ioVec = { pBuffer, bufferLength };
+
+    return socketRecvDataV( pContext, socketHandle, &ioVec, 1U, recvTimeout, pReceivedDataLength );
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t socketRecvDataV( CellularContext_t * pContext,
+                                        CellularSocketHandle_t socketHandle,
+                                        const cellularSocketIoVec_t * pIoVec,
+                                        uint32_t ioVecCount,
+                                        uint32_t recvTimeout,
+                                        uint32_t * pReceivedDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    const uint32_t bufferLength = ioVecLength( pIoVec, ioVecCount );
+    uint32_t recvLen = bufferLength;
+    _socketDataRecv_t dataRecv =
+    {
+        pReceivedDataLength,
+        pIoVec[ 0 ].pBuffer,
+        NULL,
+        pContext,
+        socketHandle,
+        bufferLength,
+        false,
+        RECV_PREFIX_STATE_MATCH,
+        0,
+        0,
+        0,
+        pIoVec,
+        ioVecCount
+    };
+    CellularAtReq_t atReqSocketRecv =
+    {
+        cmdBuf,
+        CELLULAR_AT_MULTI_DATA_WO_PREFIX,
+        "+CARECV",
+        _Cellular_RecvFuncData,
+        ( void * ) &dataRecv,
+        sizeof( _socketDataRecv_t ),
+    };
+
+    /* Update recvLen to maximum module length. */
+    if( CELLULAR_MAX_RECV_DATA_LEN <= bufferLength )
+    {
+        recvLen = ( uint32_t ) CELLULAR_MAX_RECV_DATA_LEN;
+    }
+
+    *pReceivedDataLength = 0;
+
+    (void)snprintf(cmdBuf, sizeof(cmdBuf),
+        "AT+CARECV=%ld,%ld", socketHandle->socketId, recvLen);
+    pktStatus = _Cellular_TimeoutAtcmdDataRecvRequestWithCallback( pContext,
+                                                                   atReqSocketRecv, recvTimeout, socketRecvDataPrefix, &dataRecv);
+
+    if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    {
+        /* Reset data handling parameters. */
+        LogError( ( "_Cellular_RecvData: Data Receive fail, pktStatus: %d", pktStatus ) );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t rxRingRead( cellularSocketModuleData_t * pSocketModuleData,
+                            uint8_t * pBuffer,
+                            uint32_t bufferLength )
+{
+    uint32_t readLen = 0;
+    uint32_t copyLen = 0;
+
+    while( ( readLen < bufferLength ) && ( pSocketModuleData->rxRingCount > 0U ) )
+    {
+        /* Copy up to the end of the ring, then wrap around. */
+        copyLen = pSocketModuleData->rxRingSize - pSocketModuleData->rxRingHead;
+
+        if( copyLen > pSocketModuleData->rxRingCount )
+        {
+            copyLen = pSocketModuleData->rxRingCount;
+        }
+
+        if( copyLen > ( bufferLength - readLen ) )
+        {
+            copyLen = bufferLength - readLen;
+        }
+
+        ( void ) memcpy( &pBuffer[ readLen ], &pSocketModuleData->pRxRing[ pSocketModuleData->rxRingHead ], copyLen );
+        pSocketModuleData->rxRingHead = ( pSocketModuleData->rxRingHead + copyLen ) % pSocketModuleData->rxRingSize;
+        pSocketModuleData->rxRingCount = pSocketModuleData->rxRingCount - copyLen;
+        readLen = readLen + copyLen;
+    }
+
+    return readLen;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with rxLock of the socket held. */
+static CellularError_t rxRingFill( CellularContext_t * pContext,
+                                   CellularSocketHandle_t socketHandle,
+                                   cellularSocketModuleData_t * pSocketModuleData,
+                                   uint32_t recvTimeout,
+                                   bool drainModem )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t tail = 0;
+    uint32_t freeLen = 0;
+    uint32_t recvLen = 0;
+
+    if( pSocketModuleData->rxRingCount == 0U )
+    {
+        /* Keep the free space in one piece. */
+        pSocketModuleData->rxRingHead = 0;
+    }
+
+    do
+    {
+        tail = ( pSocketModuleData->rxRingHead + pSocketModuleData->rxRingCount ) % pSocketModuleData->rxRingSize;
+
+        /* Contiguous free space after the tail. */
+        if( pSocketModuleData->rxRingCount == pSocketModuleData->rxRingSize )
+        {
+            freeLen = 0;
+        }
+        else if( tail >= pSocketModuleData->rxRingHead )
+        {
+            freeLen = pSocketModuleData->rxRingSize - tail;
+        }
+        else
+        {
+            freeLen = pSocketModuleData->rxRingHead - tail;
+        }
+
+        if( freeLen == 0U )
+        {
+            break;
+        }
+
+        cellularStatus = socketRecvData( pContext, socketHandle, &pSocketModuleData->pRxRing[ tail ],
+                                         freeLen, recvTimeout, &recvLen );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            pSocketModuleData->rxRingCount = pSocketModuleData->rxRingCount + recvLen;
+        }
+    } while( ( drainModem == true ) && ( cellularStatus == CELLULAR_SUCCESS ) && ( recvLen > 0U ) );
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t socketRecvFromRing( CellularContext_t * pContext,
+                                           cellularModuleContext_t * pModuleContext,
+                                           CellularSocketHandle_t socketHandle,
+                                           const cellularSocketIoVec_t * pIoVec,
+                                           uint32_t ioVecCount,
+                                           uint32_t recvTimeout,
+                                           uint32_t * pReceivedDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularSocketModuleData_t * pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+    uint32_t i = 0;
+    bool fetchMore = false;
+
+    *pReceivedDataLength = 0;
+
+    /* The worker may be filling the ring. Wait for it no longer than the receive
+     * timeout, and not at all on a non-blocking socket. */
+    if( xSemaphoreTake( pSocketModuleData->rxLock,
+                        ( pSocketModuleData->recvNonBlocking == true ) ? 0U : pdMS_TO_TICKS( recvTimeout ) ) != pdTRUE )
+    {
+        LogDebug( ( "socketRecvFromRing: socket %u busy, no data", socketHandle->socketId ) );
+    }
+    else
+    {
+        if( pSocketModuleData->pRxRing == NULL )
+        {
+            /* The ring was disabled after the caller checked it. */
+            cellularStatus = socketRecvDataV( pContext, socketHandle, pIoVec, ioVecCount,
+                                              recvTimeout, pReceivedDataLength );
+        }
+        else
+        {
+            if( pSocketModuleData->rxRingCount == 0U )
+            {
+                cellularStatus = rxRingFill( pContext, socketHandle, pSocketModuleData, recvTimeout, false );
+            }
+
+            for( i = 0; ( i < ioVecCount ) && ( pSocketModuleData->rxRingCount > 0U ); i++ )
+            {
+                *pReceivedDataLength = *pReceivedDataLength +
+                                       rxRingRead( pSocketModuleData, pIoVec[ i ].pBuffer, pIoVec[ i ].bufferLength );
+            }
+
+            /* Drained once the ring is empty and the modem reported +CARECV: 0.
+             * The next +CADATAIND notifies the application again. */
+            ( void ) xSemaphoreTake( pModuleContext->socketLock, portMAX_DELAY );
+
+            if( ( pSocketModuleData->rxRingCount == 0U ) && ( pSocketModuleData->rxModemData == false ) )
+            {
+                ( void ) xEventGroupClearBits( pModuleContext->rxDataEvent, RX_DATA_EVENT_BIT( socketHandle->socketId ) );
+            }
+
+            fetchMore = pSocketModuleData->rxModemData;
+            ( void ) xSemaphoreGive( pModuleContext->socketLock );
+        }
+
+        ( void ) xSemaphoreGive( pSocketModuleData->rxLock );
+
+        /* Keep the modem side drained while the application consumes the ring. */
+        if( fetchMore == true )
+        {
+            _Cellular_RequestRxFetch( pContext, pModuleContext, socketHandle->socketId );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t socketRecv( CellularContext_t * pContext,
+                                   cellularModuleContext_t * pModuleContext,
+                                   CellularSocketHandle_t socketHandle,
+                                   const cellularSocketIoVec_t * pIoVec,
+                                   uint32_t ioVecCount,
+                                   uint32_t * pReceivedDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t recvTimeout = DATA_READ_TIMEOUT_MS;
+    cellularSocketModuleData_t * pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+    const TickType_t startTick = xTaskGetTickCount();
+    const uint32_t bufferLength = ioVecLength( pIoVec, ioVecCount );
+    EventBits_t eventBits = 0;
+    bool dataIndicated = false;
+    uint32_t recvTimeoutMs = DATA_READ_TIMEOUT_MS;
+    uint32_t totalLen = 0;
+    uint32_t recvLen = 0;
+    bool moreData = false;
+    cellularSocketIoVec_t ioVecRest = { NULL, 0 };
+    const cellularSocketIoVec_t * pReadIoVec = pIoVec;
+    uint32_t readIoVecCount = ioVecCount;
+
+    *pReceivedDataLength = 0;
+
+    /* Update receive timeout to default timeout if not set with setsocketopt. */
+    if( socketHandle->recvTimeoutMs != 0U )
+    {
+        recvTimeoutMs = socketHandle->recvTimeoutMs;
+    }
+
+    recvTimeout = recvTimeoutMs;
+
+    if( pSocketModuleData->rxRingCount != 0U )
+    {
+        dataIndicated = true;
+    }
+    else
+    {
+        /* A non-blocking socket only checks for +CADATAIND without waiting. */
+        eventBits = xEventGroupWaitBits( pModuleContext->rxDataEvent, RX_DATA_EVENT_BIT( socketHandle->socketId ),
+                                         pdFALSE, pdFALSE,
+                                         ( pSocketModuleData->recvNonBlocking == true ) ? 0U : pdMS_TO_TICKS( recvTimeout ) );
+        dataIndicated = ( ( eventBits & RX_DATA_EVENT_BIT( socketHandle->socketId ) ) != 0U );
+    }
+
+    /* The receive timeout bounds the whole call, including the wait above. */
+    if( pSocketModuleData->recvNonBlocking == false )
+    {
+        recvTimeout = remainingTimeMs( startTick, recvTimeout );
+    }
+
+    if( ( dataIndicated == false ) || ( recvTimeout == 0U ) )
+    {
+        LogDebug( ( "Cellular_SocketRecv: no data on socket %u", socketHandle->socketId ) );
+    }
+    else
+    {
+        do
+        {
+            if( pSocketModuleData->pRxRing != NULL )
+            {
+                cellularStatus = socketRecvFromRing( pContext, pModuleContext, socketHandle, pReadIoVec,
+                                                     readIoVecCount, recvTimeout, &recvLen );
+            }
+            else
+            {
+                cellularStatus = socketRecvDataV( pContext, socketHandle, pReadIoVec,
+                                                  readIoVecCount, recvTimeout, &recvLen );
+            }
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                totalLen = totalLen + recvLen;
+            }
+
+            /* In drain mode keep reading until the buffer is full, +CARECV: 0
+             * clears the indication or the receive timeout expires. Drain
+             * mode fills a single buffer only. */
+            moreData = ( pSocketModuleData->recvDrain == true ) && ( ioVecCount == 1U ) &&
+                       ( cellularStatus == CELLULAR_SUCCESS ) && ( recvLen > 0U ) &&
+                       ( totalLen < bufferLength ) &&
+                       ( ( pSocketModuleData->rxRingCount != 0U ) ||
+                         ( ( xEventGroupGetBits( pModuleContext->rxDataEvent ) &
+                             RX_DATA_EVENT_BIT( socketHandle->socketId ) ) != 0U ) );
+
+            if( moreData == true )
+            {
+                recvTimeout = remainingTimeMs( startTick, recvTimeoutMs );
+                moreData = ( recvTimeout != 0U );
+                ioVecRest.pBuffer = &pIoVec[ 0 ].pBuffer[ totalLen ];
+                ioVecRest.bufferLength = bufferLength - totalLen;
+                pReadIoVec = &ioVecRest;
+                readIoVecCount = 1U;
+            }
+        } while( moreData == true );
+
+        /* Report what was read even if a later read of the drain failed. */
+        if( totalLen > 0U )
+        {
+            cellularStatus = CELLULAR_SUCCESS;
+        }
+
+        *pReceivedDataLength = totalLen;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
+                                     CellularSocketHandle_t socketHandle,
+                                     /* coverity[misra_c_2012_rule_8_13_violation] */
+                                     uint8_t * pBuffer,
+                                     uint32_t bufferLength,
+                                     /* coverity[misra_c_2012_rule_8_13_violation] */
+                                     uint32_t * pReceivedDataLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    const cellularSocketIoVec_t ioVec = { pBuffer, bufferLength };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pBuffer == NULL ) || ( pReceivedDataLength == NULL ) || ( bufferLength == 0U ) )
+    {
+        LogError( ( "_Cellular_RecvData: Bad input Param" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = socketRecv( pContext, pModuleContext, socketHandle, &ioVec, 1U, pReceivedDataLength );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketRecvv( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle,
+                                      const cellularSocketIoVec_t * pIoVec,
+                                      uint32_t ioVecCount,
+                                      uint32_t * pReceivedDataLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint32_t i = 0;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pIoVec == NULL ) || ( ioVecCount == 0U ) || ( pReceivedDataLength == NULL ) )
+    {
+        LogError( ( "Cellular_SocketRecvv: Bad input Param" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        for( i = 0; i < ioVecCount; i++ )
+        {
+            if( ( pIoVec[ i ].pBuffer == NULL ) || ( pIoVec[ i ].bufferLength == 0U ) )
+            {
+                LogError( ( "Cellular_SocketRecvv: Bad segment %u", i ) );
+                cellularStatus = CELLULAR_BAD_PARAMETER;
+                break;
+            }
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = socketRecv( pContext, pModuleContext, socketHandle, pIoVec, ioVecCount, pReceivedDataLength );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t _Cellular_SocketRxFetch( CellularContext_t * pContext,
+                                         uint32_t socketId )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    CellularSocketHandle_t socketHandle = NULL;
+
+    if( socketId >= CELLULAR_NUM_SOCKET_MAX )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketId ];
+        ( void ) xSemaphoreTake( pSocketModuleData->rxLock, portMAX_DELAY );
+
+        /* The socket may have been closed or the ring disabled since the job was posted. */
+        socketHandle = _Cellular_GetSocketData( pContext, socketId );
+
+        if( ( pSocketModuleData->pRxRing != NULL ) && ( socketHandle != NULL ) &&
+            ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) )
+        {
+            cellularStatus = rxRingFill( pContext, socketHandle, pSocketModuleData, DATA_READ_TIMEOUT_MS, true );
+            LogDebug( ( "_Cellular_SocketRxFetch: socket %u, %u bytes in ring", socketId,
+                        pSocketModuleData->rxRingCount ) );
+        }
+
+        ( void ) xSemaphoreGive( pSocketModuleData->rxLock );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SocketModuleDataReset( cellularModuleContext_t * pModuleContext,
+                                      uint32_t socketId )
+{
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+
+    if( ( pModuleContext != NULL ) && ( socketId < CELLULAR_NUM_SOCKET_MAX ) )
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketId ];
+
+        if( pSocketModuleData->pRxRing != NULL )
+        {
+            Platform_Free( pSocketModuleData->pRxRing );
+            pSocketModuleData->pRxRing = NULL;
+        }
+
+        pSocketModuleData->rxRingSize = 0;
+        pSocketModuleData->rxRingHead = 0;
+        pSocketModuleData->rxRingCount = 0;
+        pSocketModuleData->rxFetchQueued = false;
+        pSocketModuleData->rxModemData = false;
+        pSocketModuleData->recvNonBlocking = false;
+        pSocketModuleData->recvDrain = false;
+        ( void ) memset( &pSocketModuleData->recvStats, 0, sizeof( cellularSocketRecvStats_t ) );
+
+        if( pSocketModuleData->pTxBuf != NULL )
+        {
+            Platform_Free( pSocketModuleData->pTxBuf );
+            pSocketModuleData->pTxBuf = NULL;
+        }
+
+        pSocketModuleData->txBufSize = 0;
+        pSocketModuleData->txBufLen = 0;
+        pSocketModuleData->txFlushTimeoutMs = 0;
+        pSocketModuleData->txFirstTick = 0;
+        pSocketModuleData->sendAll = false;
+        ( void ) memset( &pSocketModuleData->sendStats, 0, sizeof( cellularSocketSendStats_t ) );
+        pSocketModuleData->txWindow = 0;
+        pSocketModuleData->sendNonBlocking = false;
+        pSocketModuleData->dataReadyQueued = false;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with rxLock of the socket held. */
+static CellularError_t setRxBufferSize( cellularSocketModuleData_t * pSocketModuleData,
+                                        const uint8_t * pOptionValue,
+                                        uint32_t optionValueLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t rxBufferSize = 0;
+    uint8_t * pRxRing = NULL;
+
+    if( optionValueLength != sizeof( uint32_t ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( pSocketModuleData->rxRingCount != 0U )
+    {
+        LogError( ( "setRxBufferSize: %u bytes not read yet", pSocketModuleData->rxRingCount ) );
+        cellularStatus = CELLULAR_NOT_ALLOWED;
+    }
+    else
+    {
+        ( void ) memcpy( &rxBufferSize, pOptionValue, sizeof( uint32_t ) );
+
+        if( rxBufferSize > 0U )
+        {
+            pRxRing = ( uint8_t * ) Platform_Malloc( rxBufferSize );
+
+            if( pRxRing == NULL )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( pSocketModuleData->pRxRing != NULL )
+        {
+            Platform_Free( pSocketModuleData->pRxRing );
+        }
+
+        pSocketModuleData->pRxRing = pRxRing;
+        pSocketModuleData->rxRingSize = rxBufferSize;
+        pSocketModuleData->rxRingHead = 0;
+        pSocketModuleData->rxRingCount = 0;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with txLock of the socket held. */
+static CellularError_t setTxCoalesceSize( cellularSocketModuleData_t * pSocketModuleData,
+                                          const uint8_t * pOptionValue,
+                                          uint32_t optionValueLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t txBufSize = 0;
+    uint8_t * pTxBuf = NULL;
+
+    if( optionValueLength != sizeof( uint32_t ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( pSocketModuleData->txBufLen != 0U )
+    {
+        LogError( ( "setTxCoalesceSize: %u bytes not flushed yet", pSocketModuleData->txBufLen ) );
+        cellularStatus = CELLULAR_NOT_ALLOWED;
+    }
+    else
+    {
+        ( void ) memcpy( &txBufSize, pOptionValue, sizeof( uint32_t ) );
+
+        /* One flush is one AT+CASEND. */
+        if( txBufSize > ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN )
+        {
+            txBufSize = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
+        }
+
+        if( txBufSize > 0U )
+        {
+            pTxBuf = ( uint8_t * ) Platform_Malloc( txBufSize );
+
+            if( pTxBuf == NULL )
+            {
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( pSocketModuleData->pTxBuf != NULL )
+        {
+            Platform_Free( pSocketModuleData->pTxBuf );
+        }
+
+        pSocketModuleData->pTxBuf = pTxBuf;
+        pSocketModuleData->txBufSize = txBufSize;
+
+        if( pSocketModuleData->txFlushTimeoutMs == 0U )
+        {
+            pSocketModuleData->txFlushTimeoutMs = CELLULAR_SIM70X0_TX_COALESCE_TIMEOUT_MS;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketSetModuleOpt( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle,
+                                             cellularSocketModuleOption_t option,
+                                             const uint8_t * pOptionValue,
+                                             uint32_t optionValueLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( pOptionValue == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+        ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+        ( void ) xSemaphoreTake( pSocketModuleData->rxLock, portMAX_DELAY );
+
+        switch( option )
+        {
+            case CELLULAR_SOCKET_MODULE_OPT_RX_BUFFER_SIZE:
+                cellularStatus = setRxBufferSize( pSocketModuleData, pOptionValue, optionValueLength );
+                break;
+
+            case CELLULAR_SOCKET_MODULE_OPT_RECV_NONBLOCKING:
+
+                if( optionValueLength == sizeof( bool ) )
+                {
+                    ( void ) memcpy( &pSocketModuleData->recvNonBlocking, pOptionValue, sizeof( bool ) );
+                }
+                else
+                {
+                    cellularStatus = CELLULAR_BAD_PARAMETER;
+                }
+
+                break;
+
+            case CELLULAR_SOCKET_MODULE_OPT_RECV_DRAIN:
+
+                if( optionValueLength == sizeof( bool ) )
+                {
+                    ( void ) memcpy( &pSocketModuleData->recvDrain, pOptionValue, sizeof( bool ) );
+                }
+                else
+                {
+                    cellularStatus = CELLULAR_BAD_PARAMETER;
+                }
+
+                break;
+
+            case CELLULAR_SOCKET_MODULE_OPT_SEND_ALL:
+
+                if( optionValueLength == sizeof( bool ) )
+                {
+                    ( void ) memcpy( &pSocketModuleData->sendAll, pOptionValue, sizeof( bool ) );
+                }
+                else
+                {
+                    cellularStatus = CELLULAR_BAD_PARAMETER;
+                }
+
+                break;
+
+            case CELLULAR_SOCKET_MODULE_OPT_SEND_NONBLOCKING:
+
+                if( optionValueLength == sizeof( bool ) )
+                {
+                    ( void ) memcpy( &pSocketModuleData->sendNonBlocking, pOptionValue, sizeof( bool ) );
+                }
+                else
+                {
+                    cellularStatus = CELLULAR_BAD_PARAMETER;
+                }
+
+                break;
+
+            case CELLULAR_SOCKET_MODULE_OPT_TX_WINDOW:
+
+                if( optionValueLength == sizeof( uint32_t ) )
+                {
+                    ( void ) memcpy( &pSocketModuleData->txWindow, pOptionValue, sizeof( uint32_t ) );
+                }
+                else
+                {
+                    cellularStatus = CELLULAR_BAD_PARAMETER;
+                }
+
+                break;
+
+            case CELLULAR_SOCKET_MODULE_OPT_TX_COALESCE_SIZE:
+                cellularStatus = setTxCoalesceSize( pSocketModuleData, pOptionValue, optionValueLength );
+                break;
+
+            case CELLULAR_SOCKET_MODULE_OPT_TX_COALESCE_TIMEOUT:
+
+                if( optionValueLength == sizeof( uint32_t ) )
+                {
+                    ( void ) memcpy( &pSocketModuleData->txFlushTimeoutMs, pOptionValue, sizeof( uint32_t ) );
+
+                    /* Use the default timeout if not set. */
+                    if( pSocketModuleData->txFlushTimeoutMs == 0U )
+                    {
+                        pSocketModuleData->txFlushTimeoutMs = CELLULAR_SIM70X0_TX_COALESCE_TIMEOUT_MS;
+                    }
+                }
+                else
+                {
+                    cellularStatus = CELLULAR_BAD_PARAMETER;
+                }
+
+                break;
+
+            default:
+                LogError( ( "Cellular_SocketSetModuleOpt: Option not supported %d", option ) );
+                cellularStatus = CELLULAR_UNSUPPORTED;
+                break;
+        }
+
+        ( void ) xSemaphoreGive( pSocketModuleData->rxLock );
+        ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t socketSendData( CellularContext_t * pContext,
+                                       CellularSocketHandle_t socketHandle,
+                                       const uint8_t * pData,
+                                       uint32_t dataLength,
+                                       const uint8_t * pTrailer,
+                                       uint32_t trailerLength,
+                                       uint32_t sendTimeout,
+                                       uint32_t * pSentDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    CellularAtReq_t atReqSocketSend =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+    /* The trailer is written right after the data as the end pattern of the
+     * request. The caller keeps dataLength + trailerLength within
+     * CELLULAR_MAX_SEND_DATA_LEN. */
+    CellularAtDataReq_t atDataReqSocketSend =
+    {
+        pData,
+        dataLength,
+        pSentDataLength,
+        pTrailer,
+        trailerLength
+    };
+
+    /* Send data length check. */
+    if( dataLength > ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN )
+    {
+        atDataReqSocketSend.dataLen = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
+    }
+
+    /* Form the AT command. */
+
+    /* The return value of snprintf is not used.
+     * The max length of the string is fixed and checked offline. */
+    /* coverity[misra_c_2012_rule_21_6_violation]. */
+    ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "AT+CASEND=%ld,%ld",
+                       socketHandle->socketId, atDataReqSocketSend.dataLen + trailerLength );
+
+    pktStatus = _Cellular_AtcmdDataSend( pContext, atReqSocketSend, atDataReqSocketSend,
+                                         socketSendDataPrefix, NULL,
+                                         PACKET_REQ_TIMEOUT_MS, sendTimeout, 0U );
+
+    if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    {
+        LogError( ( "Cellular_SocketSend: Data send fail, PktRet: %d", pktStatus ) );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+    else
+    {
+        /* pSentDataLength counts the data only. The trailer was sent in full
+         * or the request failed. */
+        *pSentDataLength = *pSentDataLength + trailerLength;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void recordSendStats( cellularSocketSendStats_t * pSendStats,
+                             TickType_t chunkTick,
+                             uint32_t sentLength )
+{
+    uint32_t chunkMs = ( uint32_t ) ( xTaskGetTickCount() - chunkTick ) * ( uint32_t ) portTICK_PERIOD_MS;
+
+    if( ( pSendStats->chunkCount == 0U ) || ( chunkMs < pSendStats->minChunkMs ) )
+    {
+        pSendStats->minChunkMs = chunkMs;
+    }
+
+    if( chunkMs > pSendStats->maxChunkMs )
+    {
+        pSendStats->maxChunkMs = chunkMs;
+    }
+
+    pSendStats->chunkCount++;
+    pSendStats->bytesSent = pSendStats->bytesSent + sentLength;
+    pSendStats->lastChunkMs = chunkMs;
+    pSendStats->totalChunkMs = pSendStats->totalChunkMs + chunkMs;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with txLock of the socket held. With a TX window each AT+CASEND is
+ * cut to the free window. waitWindow false sends what fits without waiting
+ * for acknowledges, the module worker must not sleep on a full window. */
+static CellularError_t socketSendChunks( CellularContext_t * pContext,
+                                         CellularSocketHandle_t socketHandle,
+                                         cellularSocketModuleData_t * pSocketModuleData,
+                                         const uint8_t * pData,
+                                         uint32_t dataLength,
+                                         uint32_t sendTimeout,
+                                         bool waitWindow,
+                                         uint32_t * pSentDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    const TickType_t startTick = xTaskGetTickCount();
+    TickType_t chunkTick = 0;
+    uint32_t chunkTimeout = sendTimeout;
+    uint32_t chunkLen = 0;
+    uint32_t sentLen = 0;
+    uint32_t totalLen = 0;
+    bool moreData = false;
+
+    do
+    {
+        chunkLen = dataLength - totalLen;
+        sentLen = 0;
+
+        if( pSocketModuleData->txWindow != 0U )
+        {
+            cellularStatus = socketTxWindowWait( pContext, socketHandle, pSocketModuleData, chunkLen,
+                                                 ( waitWindow == true ) ? chunkTimeout : 0U, &chunkLen );
+        }
+
+        if( ( cellularStatus == CELLULAR_SUCCESS ) && ( chunkLen > 0U ) )
+        {
+            chunkTick = xTaskGetTickCount();
+            cellularStatus = socketSendData( pContext, socketHandle, &pData[ totalLen ], chunkLen,
+                                             NULL, 0U, chunkTimeout, &sentLen );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                totalLen = totalLen + sentLen;
+                recordSendStats( &pSocketModuleData->sendStats, chunkTick, sentLen );
+            }
+        }
+        else if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            LogDebug( ( "socketSendChunks: TX window of socket %u is full", socketHandle->socketId ) );
+        }
+        else
+        {
+            LogDebug( ( "socketSendChunks: TX window check failed on socket %u", socketHandle->socketId ) );
+        }
+
+        /* In send all mode issue the next chunk right away. The send timeout
+         * bounds the whole call. */
+        moreData = ( pSocketModuleData->sendAll == true ) && ( cellularStatus == CELLULAR_SUCCESS ) &&
+                   ( sentLen > 0U ) && ( totalLen < dataLength );
+
+        if( moreData == true )
+        {
+            chunkTimeout = remainingTimeMs( startTick, sendTimeout );
+            moreData = ( chunkTimeout != 0U );
+        }
+    } while( moreData == true );
+
+    /* Report what was sent even if a later chunk failed. */
+    if( totalLen > 0U )
+    {
+        cellularStatus = CELLULAR_SUCCESS;
+    }
+
+    *pSentDataLength = totalLen;
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with txLock of the socket held. */
+static CellularError_t socketTxFlush( CellularContext_t * pContext,
+                                      CellularSocketHandle_t socketHandle,
+                                      cellularSocketModuleData_t * pSocketModuleData,
+                                      bool waitWindow )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t sendTimeout = DATA_SEND_TIMEOUT_MS;
+    uint32_t sentLen = 0;
+
+    if( socketHandle->sendTimeoutMs != 0U )
+    {
+        sendTimeout = socketHandle->sendTimeoutMs;
+    }
+
+    if( pSocketModuleData->txBufLen > 0U )
+    {
+        cellularStatus = socketSendChunks( pContext, socketHandle, pSocketModuleData, pSocketModuleData->pTxBuf,
+                                           pSocketModuleData->txBufLen, sendTimeout, waitWindow, &sentLen );
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            /* Drop the data like a failed Cellular_SocketSend does. */
+            LogError( ( "socketTxFlush: socket %u, %u coalesced bytes dropped",
+                        socketHandle->socketId, pSocketModuleData->txBufLen ) );
+            pSocketModuleData->txBufLen = 0;
+        }
+        else
+        {
+            if( sentLen < pSocketModuleData->txBufLen )
+            {
+                ( void ) memmove( pSocketModuleData->pTxBuf, &pSocketModuleData->pTxBuf[ sentLen ],
+                                  pSocketModuleData->txBufLen - sentLen );
+            }
+
+            pSocketModuleData->txBufLen = pSocketModuleData->txBufLen - sentLen;
+            pSocketModuleData->txFirstTick = xTaskGetTickCount();
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with txLock of the socket held. */
+static CellularError_t socketSendCoalesced( CellularContext_t * pContext,
+                                            cellularModuleContext_t * pModuleContext,
+                                            CellularSocketHandle_t socketHandle,
+                                            const uint8_t * pData,
+                                            uint32_t dataLength,
+                                            uint32_t sendTimeout,
+                                            bool waitWindow,
+                                            uint32_t * pSentDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularSocketModuleData_t * pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+    cellularWorkerJob_t job = { WORKER_JOB_TX_TIMER, NULL, 0, NULL };
+
+    /* Keep the byte order. Flush what is waiting if the new data doesn't fit behind it. */
+    if( ( pSocketModuleData->txBufLen + dataLength ) > pSocketModuleData->txBufSize )
+    {
+        cellularStatus = socketTxFlush( pContext, socketHandle, pSocketModuleData, waitWindow );
+    }
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "socketSendCoalesced: flush failed on socket %u", socketHandle->socketId ) );
+    }
+    else if( ( pSocketModuleData->txBufLen + dataLength ) <= pSocketModuleData->txBufSize )
+    {
+        if( pSocketModuleData->txBufLen == 0U )
+        {
+            /* Start the flush timeout with the first waiting byte. */
+            pSocketModuleData->txFirstTick = xTaskGetTickCount();
+            job.pContext = pContext;
+            job.socketId = socketHandle->socketId;
+            ( void ) _Cellular_PostWorkerJob( pModuleContext, &job );
+        }
+
+        ( void ) memcpy( &pSocketModuleData->pTxBuf[ pSocketModuleData->txBufLen ], pData, dataLength );
+        pSocketModuleData->txBufLen = pSocketModuleData->txBufLen + dataLength;
+        *pSentDataLength = dataLength;
+
+        if( pSocketModuleData->txBufLen == pSocketModuleData->txBufSize )
+        {
+            cellularStatus = socketTxFlush( pContext, socketHandle, pSocketModuleData, waitWindow );
+        }
+    }
+    else if( pSocketModuleData->txBufLen == 0U )
+    {
+        /* Too large to coalesce. */
+        cellularStatus = socketSendChunks( pContext, socketHandle, pSocketModuleData, pData, dataLength,
+                                           sendTimeout, waitWindow, pSentDataLength );
+    }
+    else
+    {
+        /* The modem or the TX window took part of the waiting data only. Nothing of pData is taken. */
+        *pSentDataLength = 0;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library types. */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+static CellularPktStatus_t _Cellular_RecvFuncGetAckInfo( CellularContext_t * pContext,
+                                                         const CellularATCommandResponse_t * pAtResp,
+                                                         void * pData,
+                                                         uint16_t dataLen )
+{
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+    cellularSocketAckInfo_t * pAckInfo = ( cellularSocketAckInfo_t * ) pData;
+    char * pRespLine = NULL;
+    char * pToken = NULL;
+    int32_t tempValue = 0;
+
+    if( pContext == NULL )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_INVALID_HANDLE;
+    }
+    else if( ( pAtResp == NULL ) || ( pAtResp->pItm == NULL ) ||
+             ( pAtResp->pItm->pLine == NULL ) || ( pData == NULL ) ||
+             ( dataLen != sizeof( cellularSocketAckInfo_t ) ) )
+    {
+        LogError( ( "getAckInfo: Response in invalid" ) );
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+    }
+    else
+    {
+        /* +CAACK: <totalsize>,<unacksize> */
+        pRespLine = pAtResp->pItm->pLine;
+        atCoreStatus = Cellular_ATRemoveAllWhiteSpaces( pRespLine );
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATRemovePrefix( &pRespLine );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATGetNextTok( &pRespLine, &pToken );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATStrtoi( pToken, 10, &tempValue );
+        }
+
+        if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( tempValue >= 0 ) )
+        {
+            pAckInfo->totalSent = ( uint32_t ) tempValue;
+            atCoreStatus = Cellular_ATGetNextTok( &pRespLine, &pToken );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATStrtoi( pToken, 10, &tempValue );
+        }
+
+        if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( tempValue >= 0 ) )
+        {
+            pAckInfo->unacked = ( uint32_t ) tempValue;
+        }
+        else
+        {
+            LogError( ( "getAckInfo: Unexpected +CAACK response" ) );
+            atCoreStatus = CELLULAR_AT_ERROR;
+        }
+
+        pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
+    }
+
+    return pktStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t socketGetAckInfo( CellularContext_t * pContext,
+                                         CellularSocketHandle_t socketHandle,
+                                         cellularSocketAckInfo_t * pAckInfo )
+{
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    CellularAtReq_t atReqGetAckInfo =
+    {
+        cmdBuf,
+        CELLULAR_AT_WITH_PREFIX,
+        "+CAACK:",
+        _Cellular_RecvFuncGetAckInfo,
+        pAckInfo,
+        sizeof( cellularSocketAckInfo_t ),
+    };
+
+    ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "AT+CAACK=%u", socketHandle->socketId );
+    pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetAckInfo );
+
+    return _Cellular_TranslatePktStatus( pktStatus );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with txLock of the socket held. Returns how much of dataLength fits
+ * in the TX window, 0 if the window stayed full for waitTimeout. */
+static CellularError_t socketTxWindowWait( CellularContext_t * pContext,
+                                           CellularSocketHandle_t socketHandle,
+                                           const cellularSocketModuleData_t * pSocketModuleData,
+                                           uint32_t dataLength,
+                                           uint32_t waitTimeout,
+                                           uint32_t * pAllowedLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularSocketAckInfo_t ackInfo = { 0 };
+    const TickType_t startTick = xTaskGetTickCount();
+    uint32_t freeWindow = 0;
+    uint32_t waitTime = 0;
+    bool waitAck = false;
+
+    do
+    {
+        cellularStatus = socketGetAckInfo( pContext, socketHandle, &ackInfo );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            freeWindow = ( ackInfo.unacked < pSocketModuleData->txWindow ) ?
+                         ( pSocketModuleData->txWindow - ackInfo.unacked ) : 0U;
+            waitTime = remainingTimeMs( startTick, waitTimeout );
+            waitAck = ( freeWindow == 0U ) && ( pSocketModuleData->sendNonBlocking == false ) &&
+                      ( waitTime != 0U );
+        }
+        else
+        {
+            LogDebug( ( "socketTxWindowWait: AT+CAACK failed on socket %u", socketHandle->socketId ) );
+            waitAck = false;
+        }
+
+        if( waitAck == true )
+        {
+            waitTime = ( waitTime < CELLULAR_SIM70X0_TX_WINDOW_POLL_MS ) ? waitTime : CELLULAR_SIM70X0_TX_WINDOW_POLL_MS;
+            vTaskDelay( pdMS_TO_TICKS( waitTime ) );
+        }
+    } while( waitAck == true );
+
+    *pAllowedLength = ( dataLength < freeWindow ) ? dataLength : freeWindow;
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with txLock of the socket held. waitWindow is false on the module
+ * worker, see socketSendChunks. */
+static CellularError_t socketSendLocked( CellularContext_t * pContext,
+                                         cellularModuleContext_t * pModuleContext,
+                                         CellularSocketHandle_t socketHandle,
+                                         const uint8_t * pData,
+                                         uint32_t dataLength,
+                                         bool waitWindow,
+                                         uint32_t * pSentDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t sendTimeout = DATA_SEND_TIMEOUT_MS;
+    cellularSocketModuleData_t * pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+
+    /* Check send timeout. If not set by setsockopt, use default value. */
+    if( socketHandle->sendTimeoutMs != 0U )
+    {
+        sendTimeout = socketHandle->sendTimeoutMs;
+    }
+
+    *pSentDataLength = 0;
+
+    /* The TX window is checked where AT+CASEND is issued. Data only copied
+     * to the coalescing buffer costs no AT+CAACK. */
+    if( pSocketModuleData->pTxBuf != NULL )
+    {
+        cellularStatus = socketSendCoalesced( pContext, pModuleContext, socketHandle, pData,
+                                              dataLength, sendTimeout, waitWindow, pSentDataLength );
+    }
+    else
+    {
+        cellularStatus = socketSendChunks( pContext, socketHandle, pSocketModuleData, pData, dataLength,
+                                           sendTimeout, waitWindow, pSentDataLength );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t socketSend( CellularContext_t * pContext,
+                                   cellularModuleContext_t * pModuleContext,
+                                   CellularSocketHandle_t socketHandle,
+                                   const uint8_t * pData,
+                                   uint32_t dataLength,
+                                   uint32_t * pSentDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularSocketModuleData_t * pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+
+    ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+    cellularStatus = socketSendLocked( pContext, pModuleContext, socketHandle, pData,
+                                       dataLength, true, pSentDataLength );
+    ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
+                                     CellularSocketHandle_t socketHandle,
+                                     const uint8_t * pData,
+                                     uint32_t dataLength,
+                                     /* coverity[misra_c_2012_rule_8_13_violation] */
+                                     uint32_t * pSentDataLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pData == NULL ) || ( pSentDataLength == NULL ) || ( dataLength == 0U ) )
+    {
+        LogError( ( "Cellular_SocketSend: Invalid parameter" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = socketSend( pContext, pModuleContext, socketHandle, pData,
+                                     dataLength, pSentDataLength );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with txLock of the socket held. The caller checked that the total
+ * length is not zero and fits in one AT+CASEND. */
+static CellularError_t socketSendIoVec( CellularContext_t * pContext,
+                                        CellularSocketHandle_t socketHandle,
+                                        cellularSocketModuleData_t * pSocketModuleData,
+                                        const cellularSocketIoVec_t * pIoVec,
+                                        uint32_t ioVecCount,
+                                        uint32_t * pSentDataLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint32_t sendTimeout = DATA_SEND_TIMEOUT_MS;
+    const TickType_t chunkTick = xTaskGetTickCount();
+    uint32_t lastIndex = 0;
+    uint32_t headCount = 0;
+    uint32_t headLen = 0;
+    const uint8_t * pHead = NULL;
+    const uint8_t * pTrailer = NULL;
+    uint32_t trailerLen = 0;
+    uint8_t * pStaging = NULL;
+    uint32_t i = 0;
+
+    if( socketHandle->sendTimeoutMs != 0U )
+    {
+        sendTimeout = socketHandle->sendTimeoutMs;
+    }
+
+    /* The last non-empty segment is written as the end pattern of the request.
+     * Count the non-empty segments in front of it. */
+    for( i = 0; i < ioVecCount; i++ )
+    {
+        if( pIoVec[ i ].bufferLength > 0U )
+        {
+            if( pTrailer != NULL )
+            {
+                headCount++;
+                headLen = headLen + trailerLen;
+                pHead = pIoVec[ lastIndex ].pBuffer;
+            }
+
+            lastIndex = i;
+            pTrailer = pIoVec[ i ].pBuffer;
+            trailerLen = pIoVec[ i ].bufferLength;
+        }
+    }
+
+    if( headCount == 0U )
+    {
+        /* A single segment is sent as the data. */
+        pHead = pTrailer;
+        headLen = trailerLen;
+        pTrailer = NULL;
+        trailerLen = 0;
+    }
+    else if( headCount > 1U )
+    {
+        /* Gather the segments in front of the trailer. */
+        pStaging = ( uint8_t * ) Platform_Malloc( headLen );
+
+        if( pStaging == NULL )
+        {
+            cellularStatus = CELLULAR_NO_MEMORY;
+        }
+        else
+        {
+            headLen = 0;
+
+            for( i = 0; i < lastIndex; i++ )
+            {
+                if( pIoVec[ i ].bufferLength > 0U )
+                {
+                    ( void ) memcpy( &pStaging[ headLen ], pIoVec[ i ].pBuffer, pIoVec[ i ].bufferLength );
+                    headLen = headLen + pIoVec[ i ].bufferLength;
+                }
+            }
+
+            pHead = pStaging;
+        }
+    }
+    else
+    {
+        /* Two segments go out without a copy. pHead is the first one. */
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = socketSendData( pContext, socketHandle, pHead, headLen, pTrailer, trailerLen,
+                                         sendTimeout, pSentDataLength );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            recordSendStats( &pSocketModuleData->sendStats, chunkTick, *pSentDataLength );
+        }
+    }
+
+    if( pStaging != NULL )
+    {
+        Platform_Free( pStaging );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketSendv( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle,
+                                      const cellularSocketIoVec_t * pIoVec,
+                                      uint32_t ioVecCount,
+                                      uint32_t * pSentDataLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    uint32_t totalLen = 0;
+    uint32_t i = 0;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pIoVec == NULL ) || ( ioVecCount == 0U ) || ( pSentDataLength == NULL ) )
+    {
+        LogError( ( "Cellular_SocketSendv: Invalid parameter" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        for( i = 0; ( i < ioVecCount ) && ( cellularStatus == CELLULAR_SUCCESS ); i++ )
+        {
+            totalLen = totalLen + pIoVec[ i ].bufferLength;
+
+            if( ( ( pIoVec[ i ].pBuffer == NULL ) && ( pIoVec[ i ].bufferLength > 0U ) ) ||
+                ( pIoVec[ i ].bufferLength > ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN ) ||
+                ( totalLen > ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN ) )
+            {
+                LogError( ( "Cellular_SocketSendv: Bad segment %u, total length %u", i, totalLen ) );
+                cellularStatus = CELLULAR_BAD_PARAMETER;
+            }
+        }
+
+        if( ( cellularStatus == CELLULAR_SUCCESS ) && ( totalLen == 0U ) )
+        {
+            cellularStatus = CELLULAR_BAD_PARAMETER;
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+        *pSentDataLength = 0;
+        ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+
+        /* Keep the byte order with data coalesced by Cellular_SocketSend. */
+        cellularStatus = socketTxFlush( pContext, socketHandle, pSocketModuleData, true );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = socketSendIoVec( pContext, socketHandle, pSocketModuleData,
+                                              pIoVec, ioVecCount, pSentDataLength );
+        }
+
+        ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SocketSendAsyncJob( CellularContext_t * pContext,
+                                   uint32_t socketId )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    _socketAsyncSend_t * pAsyncSend = NULL;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    CellularSocketHandle_t socketHandle = NULL;
+    uint32_t sentLen = 0;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) != CELLULAR_SUCCESS )
+    {
+        LogError( ( "_Cellular_SocketSendAsyncJob: No module context" ) );
+    }
+    else
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketId ];
+
+        do
+        {
+            socketHandle = NULL;
+            sentLen = 0;
+            ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+            pAsyncSend = pSocketModuleData->pAsyncHead;
+
+            if( pAsyncSend == NULL )
+            {
+                /* Drained. The next request posts a new job. */
+                pSocketModuleData->sendQueued = false;
+            }
+            else
+            {
+                pSocketModuleData->pAsyncHead = pAsyncSend->pNext;
+
+                /* Close drops the waiting requests under txLock, so the request
+                 * belongs to the open socket. The pin keeps its handle valid
+                 * until the callback returns, even if the callback closes it. */
+                if( _Cellular_SocketPin( pModuleContext, socketId, pAsyncSend->generation ) == false )
+                {
+                    LogError( ( "_Cellular_SocketSendAsyncJob: socket %u was closed", socketId ) );
+                    cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+                }
+                else
+                {
+                    socketHandle = pAsyncSend->socketHandle;
+
+                    if( socketHandle->socketState != SOCKETSTATE_CONNECTED )
+                    {
+                        LogError( ( "_Cellular_SocketSendAsyncJob: socket %u not connected", socketId ) );
+                        cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+                    }
+                    else
+                    {
+                        cellularStatus = socketSendLocked( pContext, pModuleContext, socketHandle,
+                                                           pAsyncSend->pData, pAsyncSend->dataLength,
+                                                           false, &sentLen );
+                    }
+                }
+            }
+
+            /* The callback may send on or close the socket. */
+            ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+
+            if( pAsyncSend != NULL )
+            {
+                if( pAsyncSend->sendCallback != NULL )
+                {
+                    pAsyncSend->sendCallback( socketHandle, cellularStatus, sentLen, pAsyncSend->pCallbackContext );
+                }
+
+                if( socketHandle != NULL )
+                {
+                    _Cellular_SocketUnpin( pModuleContext, socketId );
+                }
+
+                Platform_Free( pAsyncSend );
+            }
+        } while( pAsyncSend != NULL );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketSendAsync( CellularHandle_t cellularHandle,
+                                          CellularSocketHandle_t socketHandle,
+                                          const uint8_t * pData,
+                                          uint32_t dataLength,
+                                          bool copyData,
+                                          CellularSocketSendCallback_t sendCallback,
+                                          void * pCallbackContext )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    _socketAsyncSend_t * pAsyncSend = NULL;
+    _socketAsyncSend_t * pTail = NULL;
+    uint8_t * pDataCopy = NULL;
+    cellularWorkerJob_t job = { WORKER_JOB_SEND, NULL, 0, NULL };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pData == NULL ) || ( dataLength == 0U ) )
+    {
+        LogError( ( "Cellular_SocketSendAsync: Invalid parameter" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( socketHandle->socketState != SOCKETSTATE_CONNECTED )
+    {
+        cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* The copy of the data is allocated with the request and freed by the worker. */
+        pAsyncSend = ( _socketAsyncSend_t * ) Platform_Malloc( sizeof( _socketAsyncSend_t ) +
+                                                               ( ( copyData == true ) ? dataLength : 0U ) );
+
+        if( pAsyncSend == NULL )
+        {
+            cellularStatus = CELLULAR_NO_MEMORY;
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pAsyncSend->pNext = NULL;
+        pAsyncSend->socketHandle = socketHandle;
+        pAsyncSend->pData = pData;
+        pAsyncSend->dataLength = dataLength;
+        pAsyncSend->sendCallback = sendCallback;
+        pAsyncSend->pCallbackContext = pCallbackContext;
+
+        if( copyData == true )
+        {
+            pDataCopy = ( uint8_t * ) &pAsyncSend[ 1 ];
+            ( void ) memcpy( pDataCopy, pData, dataLength );
+            pAsyncSend->pData = pDataCopy;
+        }
+
+        pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+        ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+        pAsyncSend->generation = pSocketModuleData->generation;
+
+        if( pSocketModuleData->pAsyncHead == NULL )
+        {
+            pSocketModuleData->pAsyncHead = pAsyncSend;
+        }
+        else
+        {
+            pTail = pSocketModuleData->pAsyncHead;
+
+            while( pTail->pNext != NULL )
+            {
+                pTail = pTail->pNext;
+            }
+
+            pTail->pNext = pAsyncSend;
+        }
+
+        /* One queued job sends all requests of the socket. */
+        if( pSocketModuleData->sendQueued == false )
+        {
+            job.pContext = pContext;
+            job.socketId = socketHandle->socketId;
+
+            if( _Cellular_PostWorkerJob( pModuleContext, &job ) == true )
+            {
+                pSocketModuleData->sendQueued = true;
+            }
+            else
+            {
+                /* Without a queued job the list held only this request. */
+                pSocketModuleData->pAsyncHead = NULL;
+                Platform_Free( pAsyncSend );
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketFlush( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+        ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+        cellularStatus = socketTxFlush( pContext, socketHandle, pSocketModuleData, true );
+        ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketGetSendStats( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle,
+                                             cellularSocketSendStats_t * pSendStats )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( pSendStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+        ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+        *pSendStats = pSocketModuleData->sendStats;
+        ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketGetRecvStats( CellularHandle_t cellularHandle,
+                                             CellularSocketHandle_t socketHandle,
+                                             cellularSocketRecvStats_t * pRecvStats )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( pRecvStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Only the URC handler writes the counters. */
+        *pRecvStats = pModuleContext->socketData[ socketHandle->socketId ].recvStats;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketGetAckInfo( CellularHandle_t cellularHandle,
+                                           CellularSocketHandle_t socketHandle,
+                                           cellularSocketAckInfo_t * pAckInfo )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( pAckInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( socketHandle->socketState != SOCKETSTATE_CONNECTED )
+    {
+        LogError( ( "Cellular_SocketGetAckInfo: socket %u is not connected", socketHandle->socketId ) );
+        cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Serialize with AT+CASEND so the result matches the sent length. */
+        pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+        ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+        cellularStatus = socketGetAckInfo( pContext, socketHandle, pAckInfo );
+        ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetCallbackStats( CellularHandle_t cellularHandle,
+                                           cellularCallbackStats_t * pCallbackStats )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pCallbackStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Each counter has a single writer. A snapshot may be a callback apart. */
+        *pCallbackStats = pModuleContext->callbackStats;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetStartupStats( CellularHandle_t cellularHandle,
+                                          cellularStartupStats_t * pStartupStats )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pStartupStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Written once by Cellular_ModuleEnableUE. */
+        *pStartupStats = pModuleContext->startupStats;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+TickType_t _Cellular_SocketTxFlushExpired( CellularContext_t * pContext,
+                                           cellularModuleContext_t * pModuleContext )
+{
+    TickType_t waitTicks = portMAX_DELAY;
+    TickType_t timeoutTicks = 0;
+    TickType_t elapsedTicks = 0;
+    TickType_t remainingTicks = 0;
+    uint32_t socketId = 0;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    CellularSocketHandle_t socketHandle = NULL;
+
+    for( socketId = 0; socketId < CELLULAR_NUM_SOCKET_MAX; socketId++ )
+    {
+        pSocketModuleData = &pModuleContext->socketData[ socketId ];
+        timeoutTicks = pdMS_TO_TICKS( pSocketModuleData->txFlushTimeoutMs );
+
+        if( pSocketModuleData->txBufLen == 0U )
+        {
+            /* Nothing waiting on this socket. */
+        }
+        else if( xSemaphoreTake( pSocketModuleData->txLock, 0 ) != pdTRUE )
+        {
+            /* An application task is sending on the socket. Look again later. */
+            waitTicks = ( timeoutTicks < waitTicks ) ? timeoutTicks : waitTicks;
+        }
+        else
+        {
+            elapsedTicks = xTaskGetTickCount() - pSocketModuleData->txFirstTick;
+
+            if( pSocketModuleData->txBufLen == 0U )
+            {
+                /* Flushed while the lock was taken. */
+            }
+            else if( elapsedTicks >= timeoutTicks )
+            {
+                socketHandle = _Cellular_GetSocketData( pContext, socketId );
+
+                if( socketHandle != NULL )
+                {
+                    ( void ) socketTxFlush( pContext, socketHandle, pSocketModuleData, false );
+                }
+                else
+                {
+                    pSocketModuleData->txBufLen = 0;
+                }
+
+                /* What the modem didn't take waits another timeout. */
+                if( pSocketModuleData->txBufLen > 0U )
+                {
+                    waitTicks = ( timeoutTicks < waitTicks ) ? timeoutTicks : waitTicks;
+                }
+            }
+            else
+            {
+                remainingTicks = timeoutTicks - elapsedTicks;
+                waitTicks = ( remainingTicks < waitTicks ) ? remainingTicks : waitTicks;
+            }
+
+            ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+        }
+    }
+
+    return waitTicks;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularSocketModuleData_t * pSocketModuleData = NULL;
+    _socketAsyncSend_t * pAsyncSend = NULL;
+    _socketAsyncSend_t * pAsyncNext = NULL;
+    CellularAtReq_t atReqSockClose =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    /* Make sure the library is open. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else
+    {
+        /* Hold txLock so no send or flush runs on the socket while it is closed. */
+        if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            pSocketModuleData = &pModuleContext->socketData[ socketHandle->socketId ];
+            ( void ) xSemaphoreTake( pSocketModuleData->txLock, portMAX_DELAY );
+        }
+
+        if( ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) ||
+            ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) ||
+            ( socketHandle->socketState == SOCKETSTATE_DISCONNECTED ) )
+        {
+            /* Send what is still coalesced before the socket goes away. */
+            if( ( pSocketModuleData != NULL ) && ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) )
+            {
+                ( void ) socketTxFlush( pContext, socketHandle, pSocketModuleData, true );
+            }
+
+            /* Form the AT command. */
+
+            /* The return value of snprintf is not used.
+             * The max length of the string is fixed and checked offline. */
+            /* coverity[misra_c_2012_rule_21_6_violation]. */
+            ( void ) snprintf( cmdBuf, sizeof(cmdBuf), "AT+CACLOSE=%ld", socketHandle->socketId );
+            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSockClose,
+                                                                   SOCKET_DISCONNECT_PACKET_REQ_TIMEOUT_MS );
+
+            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            {
+                LogError( ( "Cellular_SocketClose: Socket close failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+            }
+        }
+
+        /* Hold rxLock so the worker can't fetch into the socket while it is removed. */
+        if( pSocketModuleData != NULL )
+        {
+            ( void ) xSemaphoreTake( pSocketModuleData->rxLock, portMAX_DELAY );
+            _Cellular_SocketModuleDataReset( pModuleContext, socketHandle->socketId );
+            ( void ) xEventGroupClearBits( pModuleContext->rxDataEvent, RX_DATA_EVENT_BIT( socketHandle->socketId ) );
+
+            /* Waiting async sends are completed below. A queued job finds the list empty. */
+            pAsyncSend = pSocketModuleData->pAsyncHead;
+            pSocketModuleData->pAsyncHead = NULL;
+
+            /* Ignore the result from the info, and force to remove the socket. */
+            cellularStatus = _Cellular_SocketRemove( pContext, pModuleContext, socketHandle );
+
+            ( void ) xSemaphoreGive( pSocketModuleData->rxLock );
+            ( void ) xSemaphoreGive( pSocketModuleData->txLock );
+        }
+        else
+        {
+            cellularStatus = _Cellular_RemoveSocketData( pContext, socketHandle );
+        }
+
+        /* The handle may be freed. The callbacks get NULL. */
+        while( pAsyncSend != NULL )
+        {
+            pAsyncNext = pAsyncSend->pNext;
+
+            if( pAsyncSend->sendCallback != NULL )
+            {
+                pAsyncSend->sendCallback( NULL, CELLULAR_SOCKET_NOT_CONNECTED, 0U, pAsyncSend->pCallbackContext );
+            }
+
+            Platform_Free( pAsyncSend );
+            pAsyncSend = pAsyncNext;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
+                                        CellularSocketHandle_t socketHandle,
+                                        CellularSocketAccessMode_t dataAccessMode,
+                                        const CellularSocketAddress_t * pRemoteSocketAddress )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+    CellularAtReq_t atReqSocketConnect =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    /* Make sure the library is open. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+    }
+    else if( pRemoteSocketAddress == NULL )
+    {
+        LogError( ( "Cellular_SocketConnect: Invalid socket address" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else
+    {
+        cellularStatus = storeAccessModeAndAddress( pContext, socketHandle, dataAccessMode, pRemoteSocketAddress );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Builds the Socket connect command. */
+        cellularStatus = buildSocketConnect( socketHandle, cmdBuf );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularModuleContext_t* pSimContex = (cellularModuleContext_t *)pContext->pModueContext;
+        xEventGroupClearBits(pSimContex->rxDataEvent, RX_DATA_EVENT_BIT(socketHandle->socketId));      //wait data coming
+
+        /* +CAOPEN can be handled before the OK reaches this task. The state is
+         * set first so the result of the URC isn't overwritten. */
+        socketHandle->socketState = SOCKETSTATE_CONNECTING;
+        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSocketConnect,
+                                                               SOCKET_CONNECT_PACKET_REQ_TIMEOUT_MS );
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogError( ( "Cellular_SocketConnect: Socket connect failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            socketHandle->socketState = SOCKETSTATE_ALLOCATED;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Connect to one address. Waits up to CELLULAR_SIM70X0_CONNECT_ATTEMPT_TIMEOUT_MS
+ * for the +CAOPEN result and returns the socket to SOCKETSTATE_ALLOCATED if
+ * it doesn't connect, so the next address can be tried on it. */
+static CellularError_t socketConnectAttempt( CellularContext_t * pContext,
+                                             CellularSocketHandle_t socketHandle,
+                                             CellularSocketAccessMode_t dataAccessMode,
+                                             const CellularSocketAddress_t * pRemoteSocketAddress )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    const TickType_t startTick = xTaskGetTickCount();
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    CellularAtReq_t atReqSockClose =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    cellularStatus = Cellular_SocketConnect( pContext, socketHandle, dataAccessMode, pRemoteSocketAddress );
+
+    while( ( cellularStatus == CELLULAR_SUCCESS ) && ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) &&
+           ( remainingTimeMs( startTick, CELLULAR_SIM70X0_CONNECT_ATTEMPT_TIMEOUT_MS ) > 0U ) )
+    {
+        vTaskDelay( pdMS_TO_TICKS( CONNECT_ATTEMPT_POLL_MS ) );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( socketHandle->socketState != SOCKETSTATE_CONNECTED ) )
+    {
+        if( socketHandle->socketState == SOCKETSTATE_CONNECTING )
+        {
+            /* Abandon the connection the modem is still trying. */
+            ( void ) snprintf( cmdBuf, sizeof( cmdBuf ), "AT+CACLOSE=%ld", socketHandle->socketId );
+            ( void ) _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSockClose,
+                                                                SOCKET_DISCONNECT_PACKET_REQ_TIMEOUT_MS );
+            cellularStatus = CELLULAR_TIMEOUT;
+        }
+        else
+        {
+            cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+        }
+
+        socketHandle->socketState = SOCKETSTATE_ALLOCATED;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_SocketConnectAny( CellularHandle_t cellularHandle,
+                                           CellularSocketHandle_t socketHandle,
+                                           CellularSocketAccessMode_t dataAccessMode,
+                                           const cellularDnsResult_t * pDnsResult,
+                                           uint16_t port,
+                                           uint8_t * pConnectedIndex )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularSocketAddress_t remoteSocketAddress;
+    uint8_t i = 0;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pDnsResult == NULL ) || ( pDnsResult->addressCount == 0U ) ||
+             ( pDnsResult->addressCount > CELLULAR_SIM70X0_DNS_MAX_ADDRESSES ) || ( pConnectedIndex == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        for( i = 0; i < pDnsResult->addressCount; i++ )
+        {
+            ( void ) memset( &remoteSocketAddress, 0, sizeof( remoteSocketAddress ) );
+            remoteSocketAddress.ipAddress.ipAddressType =
+                ( strchr( pDnsResult->addresses[ i ], ':' ) != NULL ) ? CELLULAR_IP_ADDRESS_V6 : CELLULAR_IP_ADDRESS_V4;
+            ( void ) strncpy( remoteSocketAddress.ipAddress.ipAddress, pDnsResult->addresses[ i ],
+                              CELLULAR_IP_ADDRESS_MAX_SIZE );
+            remoteSocketAddress.port = port;
+
+            cellularStatus = socketConnectAttempt( pContext, socketHandle, dataAccessMode, &remoteSocketAddress );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                *pConnectedIndex = i;
+                break;
+            }
+
+            LogWarn( ( "Cellular_SocketConnectAny: %s:%u failed %d",
+                       pDnsResult->addresses[ i ], port, cellularStatus ) );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+CellularError_t Cellular_GetPdnStatus( CellularHandle_t cellularHandle,
+                                       CellularPdnStatus_t * pPdnStatusBuffers,
+                                       uint8_t numStatusBuffers,
+                                       uint8_t * pNumStatus )
+{
+    return Cellular_GetPdnStatusCached( cellularHandle, pPdnStatusBuffers, NULL,
+                                        numStatusBuffers, pNumStatus, false );
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetPdnStatusCached( CellularHandle_t cellularHandle,
+                                             CellularPdnStatus_t * pPdnStatusBuffers,
+                                             TickType_t * pStateTicks,
+                                             uint8_t numStatusBuffers,
+                                             uint8_t * pNumStatus,
+                                             bool forceRefresh )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    const cellularPdnContext_t * pPdnContext = NULL;
+    CellularPdnStatus_t * pPdnStatus = NULL;
+    bool refresh = forceRefresh;
+    uint8_t cid = 0;
+
+    if( ( pPdnStatusBuffers == NULL ) || ( pNumStatus == NULL ) || ( numStatusBuffers < 1u ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+        LogWarn( ( "_Cellular_GetPdnStatus: Bad input Parameter " ) );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Make sure the library is open. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+
+        if( pModuleContext->pdnStateRefreshed == false )
+        {
+            refresh = true;
+        }
+
+        for( cid = 0; ( refresh == false ) && ( cid <= CELLULAR_CID_MAX ); cid++ )
+        {
+            if( ( pModuleContext->pdnContexts[ cid ].active == true ) &&
+                ( pModuleContext->pdnContexts[ cid ].addressKnown == false ) )
+            {
+                refresh = true;
+            }
+        }
+
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( refresh == true ) )
+    {
+        cellularStatus = pdnStateRefresh( pContext, pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Populate the Valid number of statuses. The context ID of the first
+         * invalid PDN status is set to FF. */
+        *pNumStatus = 0;
+        pPdnStatusBuffers[ 0 ].contextId = INVALID_PDN_INDEX;
+        ( void ) xSemaphoreTake( pModuleContext->pdnLock, portMAX_DELAY );
+
+        for( cid = 0; ( cid <= CELLULAR_CID_MAX ) && ( *pNumStatus < numStatusBuffers ); cid++ )
+        {
+            pPdnContext = &pModuleContext->pdnContexts[ cid ];
+
+            if( pPdnContext->stateKnown == true )
+            {
+                pPdnStatus = &pPdnStatusBuffers[ *pNumStatus ];
+                ( void ) memset( pPdnStatus, 0, sizeof( CellularPdnStatus_t ) );
+                pPdnStatus->contextId = ( uint8_t ) cid2pdn( cid );
+                pPdnStatus->state = ( pPdnContext->active == true ) ? 1U : 0U;
+                pPdnStatus->pdnContextType = CELLULAR_PDN_CONTEXT_IPV4;
+                pPdnStatus->ipAddress.ipAddressType = CELLULAR_IP_ADDRESS_V4;
+                ( void ) strncpy( pPdnStatus->ipAddress.ipAddress, pPdnContext->ipAddress,
+                                  CELLULAR_IP_ADDRESS_MAX_SIZE + 1U );
+
+                if( pStateTicks != NULL )
+                {
+                    pStateTicks[ *pNumStatus ] = pPdnContext->stateTick;
+                }
+
+                ( *pNumStatus ) += 1U;
+            }
+        }
+
+        ( void ) xSemaphoreGive( pModuleContext->pdnLock );
+
+        if( *pNumStatus < numStatusBuffers )
+        {
+            pPdnStatusBuffers[ *pNumStatus ].contextId = INVALID_PDN_INDEX;
+        }
     }
-    else if( socketHandle == NULL )
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
+                                           CellularSimCardStatus_t * pSimCardStatus )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularAtReq_t atReqGetSimLockStatus =
     {
-        cellularStatus = CELLULAR_INVALID_HANDLE;
+        "AT+CPIN?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CPIN",
+        _Cellular_RecvFuncGetSimLockStatus,
+        &pSimCardStatus->simCardLockState,
+        sizeof( CellularSimCardLockState_t ),
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSimCardStatus == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        if( ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) ||
-            ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) ||
-            ( socketHandle->socketState == SOCKETSTATE_DISCONNECTED ) )
-        {
-            /* Form the AT command. */
-
-            /* The return value of snprintf is not used.
-             * The max length of the string is fixed and checked offline. */
-            /* coverity[misra_c_2012_rule_21_6_violation]. */
-            ( void ) snprintf( cmdBuf, sizeof(cmdBuf), "AT+CACLOSE=%ld", socketHandle->socketId );
-            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSockClose,
-                                                                   SOCKET_DISCONNECT_PACKET_REQ_TIMEOUT_MS );
-
-            if( pktStatus != CELLULAR_PKT_STATUS_OK )
-            {
-                LogError( ( "Cellular_SocketClose: Socket close failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
-            }
-        }
+        /* Initialize the sim state and the sim lock state. */
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimLockStatus );
 
-        /* Ignore the result from the info, and force to remove the socket. */
-        cellularStatus = _Cellular_RemoveSocketData( pContext, socketHandle );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        LogDebug( ( "_Cellular_GetSimStatus, Sim Insert State[%d], Lock State[%d]",
+                    pSimCardStatus->simCardState, pSimCardStatus->simCardLockState ) );
     }
 
     return cellularStatus;
@@ -2602,69 +6033,329 @@ CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
 
 /* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
-                                        CellularSocketHandle_t socketHandle,
-                                        CellularSocketAccessMode_t dataAccessMode,
-                                        const CellularSocketAddress_t * pRemoteSocketAddress )
+CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
+                                         CellularSimCardInfo_t * pSimCardInfo )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSocketConnect =
+
+    CellularAtReq_t atReqGetIccid =
     {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
+        "AT+CCID",
+        CELLULAR_AT_WO_PREFIX,
         NULL,
+        _Cellular_RecvFuncGetIccid,
+        pSimCardInfo->iccid,
+        CELLULAR_ICCID_MAX_SIZE + 1U,
+    };
+    CellularAtReq_t atReqGetImsi =
+    {
+        "AT+CIMI",
+        CELLULAR_AT_WO_PREFIX,
         NULL,
-        0,
+        _Cellular_RecvFuncGetImsi,
+        pSimCardInfo->imsi,
+        CELLULAR_IMSI_MAX_SIZE + 1U,
+    };
+    CellularAtReq_t atReqGetHplmn =
+    {
+        "AT+CRSM=176,28514,0,0,0",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CRSM",
+        _Cellular_RecvFuncGetHplmn,
+        &pSimCardInfo->plmn,
+        sizeof( CellularPlmnInfo_t ),
     };
 
-    /* Make sure the library is open. */
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pRemoteSocketAddress == NULL )
+    else if( pSimCardInfo == NULL )
     {
-        LogError( ( "Cellular_SocketConnect: Invalid socket address" ) );
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
-    else if( socketHandle == NULL )
+    else
     {
-        cellularStatus = CELLULAR_INVALID_HANDLE;
+        ( void ) memset( pSimCardInfo, 0, sizeof( CellularSimCardInfo_t ) );
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetImsi );
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetHplmn );
+        }
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetIccid );
+        }
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+        else
+        {
+            LogDebug( ( "SimInfo updated: IMSI:%s, Hplmn:%s%s, ICCID:%s",
+                        pSimCardInfo->imsi, pSimCardInfo->plmn.mcc, pSimCardInfo->plmn.mnc,
+                        pSimCardInfo->iccid ) );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* FreeRTOS Cellular Library API. */
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_RegisterUrcSignalStrengthChangedCallback( CellularHandle_t cellularHandle,
+                                                                   CellularUrcSignalStrengthChangedCallback_t signalStrengthChangedCallback,
+                                                                   void * pCallbackContext )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+
+    /* pContext is checked in the common library. */
+    cellularStatus = Cellular_CommonRegisterUrcSignalStrengthChangedCallback(
+        cellularHandle, signalStrengthChangedCallback, pCallbackContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( signalStrengthChangedCallback != NULL )
+        {
+            cellularStatus = controlSignalStrengthIndication( pContext, true );
+        }
+        else
+        {
+            cellularStatus = controlSignalStrengthIndication( pContext, false );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static bool dnsCacheEntryLive( const cellularDnsCacheEntry_t * pEntry,
+                               TickType_t nowTick )
+{
+    TickType_t ttlTicks = pdMS_TO_TICKS( CELLULAR_SIM70X0_DNS_CACHE_TTL_MS );
+
+    if( pEntry->dnsResult.addressCount == 0U )
+    {
+        ttlTicks = pdMS_TO_TICKS( CELLULAR_SIM70X0_DNS_NEGATIVE_TTL_MS );
+    }
+
+    return ( pEntry->hostName[ 0 ] != '\0' ) && ( ( nowTick - pEntry->storedTick ) < ttlTicks );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called with dnsCacheLock held. */
+static cellularDnsCacheEntry_t * dnsCacheFind( cellularModuleContext_t * pModuleContext,
+                                               uint8_t contextId,
+                                               const char * pcHostName )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    uint32_t i = 0;
+
+    for( i = 0; i < CELLULAR_SIM70X0_DNS_CACHE_SIZE; i++ )
+    {
+        if( ( pModuleContext->dnsCache[ i ].hostName[ 0 ] != '\0' ) &&
+            ( pModuleContext->dnsCache[ i ].contextId == contextId ) &&
+            ( strcmp( pModuleContext->dnsCache[ i ].hostName, pcHostName ) == 0 ) )
+        {
+            pEntry = &pModuleContext->dnsCache[ i ];
+            break;
+        }
+    }
+
+    return pEntry;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns true if the cache answered the lookup. pCachedStatus is then the
+ * result of the cached query. */
+static bool dnsCacheLookup( cellularModuleContext_t * pModuleContext,
+                            uint8_t contextId,
+                            const char * pcHostName,
+                            cellularDnsResult_t * pDnsResult,
+                            CellularError_t * pCachedStatus )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    const TickType_t nowTick = xTaskGetTickCount();
+    bool cacheHit = false;
+
+    ( void ) xSemaphoreTake( pModuleContext->dnsCacheLock, portMAX_DELAY );
+
+    if( ( CELLULAR_SIM70X0_DNS_CACHE_TTL_MS != 0U ) &&
+        ( strlen( pcHostName ) <= CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN ) )
+    {
+        pEntry = dnsCacheFind( pModuleContext, contextId, pcHostName );
+    }
+
+    if( ( pEntry != NULL ) && ( dnsCacheEntryLive( pEntry, nowTick ) == true ) )
+    {
+        pEntry->lastUsedTick = nowTick;
+        cacheHit = true;
+
+        if( pEntry->dnsResult.addressCount != 0U )
+        {
+            *pDnsResult = pEntry->dnsResult;
+            *pCachedStatus = CELLULAR_SUCCESS;
+            pModuleContext->dnsCacheStats.hits++;
+        }
+        else
+        {
+            *pCachedStatus = CELLULAR_UNKNOWN;
+            pModuleContext->dnsCacheStats.negativeHits++;
+        }
     }
     else
     {
-        cellularStatus = storeAccessModeAndAddress( pContext, socketHandle, dataAccessMode, pRemoteSocketAddress );
+        pModuleContext->dnsCacheStats.misses++;
+    }
+
+    ( void ) xSemaphoreGive( pModuleContext->dnsCacheLock );
+
+    return cacheHit;
+}
+
+/*-----------------------------------------------------------*/
+
+/* pDnsResult NULL stores a failed lookup. */
+static void dnsCacheStore( cellularModuleContext_t * pModuleContext,
+                           uint8_t contextId,
+                           const char * pcHostName,
+                           const cellularDnsResult_t * pDnsResult )
+{
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    cellularDnsCacheEntry_t * pCandidate = NULL;
+    const TickType_t nowTick = xTaskGetTickCount();
+    uint32_t i = 0;
+
+    if( ( CELLULAR_SIM70X0_DNS_CACHE_TTL_MS == 0U ) ||
+        ( ( pDnsResult == NULL ) && ( CELLULAR_SIM70X0_DNS_NEGATIVE_TTL_MS == 0U ) ) ||
+        ( strlen( pcHostName ) > CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN ) )
+    {
+        /* Not cached. */
+    }
+    else
+    {
+        ( void ) xSemaphoreTake( pModuleContext->dnsCacheLock, portMAX_DELAY );
+        pEntry = dnsCacheFind( pModuleContext, contextId, pcHostName );
+
+        /* Otherwise take a free or expired entry, or evict the least recently used. */
+        for( i = 0; ( pEntry == NULL ) && ( i < CELLULAR_SIM70X0_DNS_CACHE_SIZE ); i++ )
+        {
+            pCandidate = &pModuleContext->dnsCache[ i ];
+
+            if( dnsCacheEntryLive( pCandidate, nowTick ) == false )
+            {
+                pEntry = pCandidate;
+            }
+        }
+
+        if( pEntry == NULL )
+        {
+            pEntry = &pModuleContext->dnsCache[ 0 ];
+
+            for( i = 1; i < CELLULAR_SIM70X0_DNS_CACHE_SIZE; i++ )
+            {
+                pCandidate = &pModuleContext->dnsCache[ i ];
+
+                if( ( nowTick - pCandidate->lastUsedTick ) > ( nowTick - pEntry->lastUsedTick ) )
+                {
+                    pEntry = pCandidate;
+                }
+            }
+
+            LogDebug( ( "dnsCacheStore: %s evicted", pEntry->hostName ) );
+            pModuleContext->dnsCacheStats.evictions++;
+        }
+
+        ( void ) strncpy( pEntry->hostName, pcHostName, CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN );
+        pEntry->hostName[ CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN ] = '\0';
+        pEntry->contextId = contextId;
+        pEntry->dnsResult.addressCount = 0;
+
+        if( pDnsResult != NULL )
+        {
+            pEntry->dnsResult = *pDnsResult;
+        }
+
+        pEntry->storedTick = nowTick;
+        pEntry->lastUsedTick = nowTick;
+        ( void ) xSemaphoreGive( pModuleContext->dnsCacheLock );
     }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Resolve pcHostName from the DNS cache or with AT+CDNSGIP. */
+static CellularError_t getHostByName( CellularContext_t * pContext,
+                                      uint8_t contextId,
+                                      const char * pcHostName,
+                                      cellularDnsResult_t * pDnsResult )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint32_t queryIndex = CELLULAR_SIM70X0_DNS_MAX_QUERIES;
+    const uint32_t waitMs = dnsQueryWaitMs( CELLULAR_SIM70X0_DNS_TIMEOUT_MS );
+    bool cacheHit = false;
+    bool sendQuery = false;
+    bool done = false;
+
+    cellularStatus = _Cellular_IsValidPdn( contextId );
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* Builds the Socket connect command. */
-        cellularStatus = buildSocketConnect( socketHandle, cmdBuf );
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        cellularModuleContext_t* pSimContex = (cellularModuleContext_t *)pContext->pModueContext;
-        xEventGroupClearBits(pSimContex->pdnEvent, EVENT_BIT_RX_DATA);      //wait data coming
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSocketConnect,
-                                                               SOCKET_CONNECT_PACKET_REQ_TIMEOUT_MS );
+        cacheHit = dnsCacheLookup( pModuleContext, contextId, pcHostName, pDnsResult, &cellularStatus );
+    }
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) )
+    {
+        queryIndex = dnsQueryStart( pModuleContext, contextId, pcHostName, waitMs, NULL, NULL, 0, &sendQuery );
+
+        if( queryIndex >= CELLULAR_SIM70X0_DNS_MAX_QUERIES )
         {
-            LogError( ( "Cellular_SocketConnect: Socket connect failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            LogError( ( "getHostByName: %u queries in flight already", CELLULAR_SIM70X0_DNS_MAX_QUERIES ) );
+            cellularStatus = CELLULAR_NO_MEMORY;
         }
-        else
+    }
+
+    /* Send the AT command unless the same query is in flight already. */
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) && ( sendQuery == true ) )
+    {
+        cellularStatus = dnsQuerySend( pContext, contextId, pcHostName, CELLULAR_SIM70X0_DNS_TIMEOUT_MS );
+
+        if( cellularStatus != CELLULAR_SUCCESS )
         {
-            socketHandle->socketState = SOCKETSTATE_CONNECTING;
+            dnsQueryAbort( pModuleContext, queryIndex );
         }
     }
 
+    /* The +CDNSGIP handler sets the event bit of the slot. */
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) )
+    {
+        ( void ) xEventGroupWaitBits( pModuleContext->dnsEvent, DNS_EVENT_BIT( queryIndex ),
+                                      pdTRUE, pdFALSE, pdMS_TO_TICKS( waitMs ) );
+        done = dnsQueryRelease( pModuleContext, queryIndex, &dnsQueryResult, pDnsResult );
+        cellularStatus = dnsQueryStatus( pModuleContext, contextId, pcHostName, done, dnsQueryResult, pDnsResult );
+    }
+
     return cellularStatus;
 }
 
@@ -2672,68 +6363,34 @@ CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
 
 /* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-/* coverity[misra_c_2012_rule_8_13_violation] */
-CellularError_t Cellular_GetPdnStatus( CellularHandle_t cellularHandle,
-                                       CellularPdnStatus_t * pPdnStatusBuffers,
-                                       uint8_t numStatusBuffers,
-                                       uint8_t * pNumStatus )
+CellularError_t Cellular_GetHostByName( CellularHandle_t cellularHandle,
+                                        uint8_t contextId,
+                                        const char * pcHostName,
+                                        char * pResolvedAddress )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    const CellularPdnStatus_t * pTempPdnStatusBuffer = pPdnStatusBuffers;
-    uint8_t numBuffers = 0;
-    CellularAtReq_t atReqGetPdnStatus =
-    {
-        "AT+CNACT?",
-        CELLULAR_AT_MULTI_WITH_PREFIX,  //CELLULAR_AT_WITH_PREFIX,
-        "+CNACT",
-        _Cellular_RecvFuncGetPdnStatus,
-        pPdnStatusBuffers,
-        numStatusBuffers,
-    };
+    cellularDnsResult_t dnsResult;
 
-    if( ( pTempPdnStatusBuffer == NULL ) || ( pNumStatus == NULL ) || ( numStatusBuffers < 1u ) )
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
     {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
-        LogWarn( ( "_Cellular_GetPdnStatus: Bad input Parameter " ) );
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-
-    if( cellularStatus == CELLULAR_SUCCESS )
+    else if( ( pcHostName == NULL ) || ( pResolvedAddress == NULL ) )
     {
-        /* Make sure the library is open. */
-        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
     }
-
-    if( cellularStatus == CELLULAR_SUCCESS )
+    else
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetPdnStatus );
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        cellularStatus = getHostByName( pContext, contextId, pcHostName, &dnsResult );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* Populate the Valid number of statuses. */
-        *pNumStatus = 0;
-        numBuffers = numStatusBuffers;
-
-        while( numBuffers != 0U )
-        {
-            /* Check if the PDN state is valid. The context ID of the first
-             * invalid PDN status is set to FF. */
-            if( ( pTempPdnStatusBuffer->contextId <= CELLULAR_PDN_CONTEXT_ID_MAX ) &&
-                ( pTempPdnStatusBuffer->contextId != INVALID_PDN_INDEX ) )
-            {
-                ( *pNumStatus ) += 1U;
-            }
-            else
-            {
-                break;
-            }
-
-            numBuffers--;
-            pTempPdnStatusBuffer++;
-        }
+        ( void ) strncpy( pResolvedAddress, dnsResult.addresses[ 0 ], CELLULAR_IP_ADDRESS_MAX_SIZE );
     }
 
     return cellularStatus;
@@ -2741,43 +6398,28 @@ CellularError_t Cellular_GetPdnStatus( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
-                                           CellularSimCardStatus_t * pSimCardStatus )
+CellularError_t Cellular_GetHostByNameAll( CellularHandle_t cellularHandle,
+                                           uint8_t contextId,
+                                           const char * pcHostName,
+                                           cellularDnsResult_t * pDnsResult )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    CellularAtReq_t atReqGetSimLockStatus =
-    {
-        "AT+CPIN?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+CPIN",
-        _Cellular_RecvFuncGetSimLockStatus,
-        &pSimCardStatus->simCardLockState,
-        sizeof( CellularSimCardLockState_t ),
-    };
 
-    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pSimCardStatus == NULL )
+    else if( ( pcHostName == NULL ) || ( pDnsResult == NULL ) )
     {
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        /* Initialize the sim state and the sim lock state. */
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimLockStatus );
-
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-        LogDebug( ( "_Cellular_GetSimStatus, Sim Insert State[%d], Lock State[%d]",
-                    pSimCardStatus->simCardState, pSimCardStatus->simCardLockState ) );
+        cellularStatus = getHostByName( pContext, contextId, pcHostName, pDnsResult );
     }
 
     return cellularStatus;
@@ -2785,78 +6427,89 @@ CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
-                                         CellularSimCardInfo_t * pSimCardInfo )
+CellularError_t Cellular_GetHostByNameAsync( CellularHandle_t cellularHandle,
+                                             uint8_t contextId,
+                                             const char * pcHostName,
+                                             uint32_t timeoutMs,
+                                             CellularDnsCallback_t callback,
+                                             void * pUserData,
+                                             uint32_t * pRequestId )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-
-    CellularAtReq_t atReqGetIccid =
-    {
-        "AT+CCID",
-        CELLULAR_AT_WO_PREFIX,
-        NULL,
-        _Cellular_RecvFuncGetIccid,
-        pSimCardInfo->iccid,
-        CELLULAR_ICCID_MAX_SIZE + 1U,
-    };
-    CellularAtReq_t atReqGetImsi =
-    {
-        "AT+CIMI",
-        CELLULAR_AT_WO_PREFIX,
-        NULL,
-        _Cellular_RecvFuncGetImsi,
-        pSimCardInfo->imsi,
-        CELLULAR_IMSI_MAX_SIZE + 1U,
-    };
-    CellularAtReq_t atReqGetHplmn =
-    {
-        "AT+CRSM=176,28514,0,0,0",
-        CELLULAR_AT_WITH_PREFIX,
-        "+CRSM",
-        _Cellular_RecvFuncGetHplmn,
-        &pSimCardInfo->plmn,
-        sizeof( CellularPlmnInfo_t ),
-    };
+    CellularError_t cachedStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularDnsResult_t dnsResult;
+    uint32_t queryIndex = CELLULAR_SIM70X0_DNS_MAX_QUERIES;
+    bool cacheHit = false;
+    bool sendQuery = false;
+    const cellularWorkerJob_t job = { WORKER_JOB_DNS_TIMER, NULL, 0, NULL };
 
-    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pSimCardInfo == NULL )
+    else if( ( pcHostName == NULL ) || ( callback == NULL ) || ( pRequestId == NULL ) || ( timeoutMs == 0U ) ||
+             ( strlen( pcHostName ) > CELLULAR_SIM70X0_DNS_CACHE_HOST_MAX_LEN ) )
     {
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        ( void ) memset( pSimCardInfo, 0, sizeof( CellularSimCardInfo_t ) );
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetImsi );
+        cellularStatus = _Cellular_IsValidPdn( contextId );
+    }
 
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
-        {
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetHplmn );
-        }
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
 
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        *pRequestId = dnsNextRequestId( pModuleContext );
+        cacheHit = dnsCacheLookup( pModuleContext, contextId, pcHostName, &dnsResult, &cachedStatus );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == true ) )
+    {
+        callback( *pRequestId, pcHostName, cachedStatus,
+                  ( cachedStatus == CELLULAR_SUCCESS ) ? &dnsResult : NULL, pUserData );
+    }
+    else if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        queryIndex = dnsQueryStart( pModuleContext, contextId, pcHostName, dnsQueryWaitMs( timeoutMs ),
+                                    callback, pUserData, *pRequestId, &sendQuery );
+
+        if( queryIndex >= CELLULAR_SIM70X0_DNS_MAX_QUERIES )
         {
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetIccid );
+            LogError( ( "Cellular_GetHostByNameAsync: %u queries in flight already", CELLULAR_SIM70X0_DNS_MAX_QUERIES ) );
+            cellularStatus = CELLULAR_NO_MEMORY;
         }
+    }
+    else
+    {
+        /* Empty else MISRA 15.7 */
+    }
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) && ( sendQuery == true ) )
+    {
+        cellularStatus = dnsQuerySend( pContext, contextId, pcHostName, timeoutMs );
+
+        if( cellularStatus != CELLULAR_SUCCESS )
         {
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            dnsQueryAbort( pModuleContext, queryIndex );
         }
-        else
+    }
+
+    /* Let the worker pick up the timeout of the new query. */
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheHit == false ) )
+    {
+        if( _Cellular_PostWorkerJob( pModuleContext, &job ) == false )
         {
-            LogDebug( ( "SimInfo updated: IMSI:%s, Hplmn:%s%s, ICCID:%s",
-                        pSimCardInfo->imsi, pSimCardInfo->plmn.mcc, pSimCardInfo->plmn.mnc,
-                        pSimCardInfo->iccid ) );
+            LogWarn( ( "Cellular_GetHostByNameAsync: worker busy, timeout of request %u may be late", *pRequestId ) );
         }
     }
 
@@ -2865,29 +6518,45 @@ CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_RegisterUrcSignalStrengthChangedCallback( CellularHandle_t cellularHandle,
-                                                                   CellularUrcSignalStrengthChangedCallback_t signalStrengthChangedCallback,
-                                                                   void * pCallbackContext )
+CellularError_t Cellular_GetHostByNameCancel( CellularHandle_t cellularHandle,
+                                              uint32_t requestId )
 {
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularDnsQuery_t * pQuery = NULL;
+    uint32_t i = 0;
 
-    /* pContext is checked in the common library. */
-    cellularStatus = Cellular_CommonRegisterUrcSignalStrengthChangedCallback(
-        cellularHandle, signalStrengthChangedCallback, pCallbackContext );
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        if( signalStrengthChangedCallback != NULL )
-        {
-            cellularStatus = controlSignalStrengthIndication( pContext, true );
-        }
-        else
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+        PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
+
+        for( i = 0; i < CELLULAR_SIM70X0_DNS_MAX_QUERIES; i++ )
         {
-            cellularStatus = controlSignalStrengthIndication( pContext, false );
+            pQuery = &pModuleContext->dnsQueries[ i ];
+
+            if( ( pQuery->pcHostName != NULL ) && ( pQuery->callback != NULL ) && ( pQuery->requestId == requestId ) )
+            {
+                pQuery->pcHostName = NULL;
+                cellularStatus = CELLULAR_SUCCESS;
+                break;
+            }
         }
+
+        PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
     }
 
     return cellularStatus;
@@ -2895,95 +6564,77 @@ CellularError_t Cellular_RegisterUrcSignalStrengthChangedCallback( CellularHandl
 
 /*-----------------------------------------------------------*/
 
-/* FreeRTOS Cellular Library API. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
-CellularError_t Cellular_GetHostByName( CellularHandle_t cellularHandle,
-                                        uint8_t contextId,
-                                        const char * pcHostName,
-                                        char * pResolvedAddress )
+CellularError_t Cellular_DnsCacheFlush( CellularHandle_t cellularHandle,
+                                        const char * pcHostName )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE ];
-    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
     cellularModuleContext_t * pModuleContext = NULL;
-    CellularAtReq_t atReqQueryDns =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
+    cellularDnsCacheEntry_t * pEntry = NULL;
+    uint32_t i = 0;
 
-    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( ( pcHostName == NULL ) || ( pResolvedAddress == NULL ) )
-    {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
-    }
     else
     {
-        cellularStatus = _Cellular_IsValidPdn( contextId );
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+        ( void ) xSemaphoreTake( pModuleContext->dnsCacheLock, portMAX_DELAY );
+
+        for( i = 0; i < CELLULAR_SIM70X0_DNS_CACHE_SIZE; i++ )
+        {
+            pEntry = &pModuleContext->dnsCache[ i ];
+
+            if( ( pcHostName == NULL ) || ( strcmp( pEntry->hostName, pcHostName ) == 0 ) )
+            {
+                pEntry->hostName[ 0 ] = '\0';
+            }
+        }
+
+        ( void ) xSemaphoreGive( pModuleContext->dnsCacheLock );
     }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* coverity[misra_c_2012_rule_8_7_violation] */
+CellularError_t Cellular_GetDnsCacheStats( CellularHandle_t cellularHandle,
+                                           cellularDnsCacheStats_t * pDnsCacheStats )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
     {
-        PlatformMutex_Lock( &pModuleContext->dnsQueryMutex );
-        pModuleContext->dnsResultNumber = 0;
-        pModuleContext->dnsIndex = 0;
-        ( void ) xQueueReset( pModuleContext->pktDnsQueue );
-        cellularStatus = registerDnsEventCallback( pModuleContext, _dnsResultCallback, pResolvedAddress );
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-
-    /* Send the AT command and wait the URC result. */
-    if( cellularStatus == CELLULAR_SUCCESS )
+    else if( pDnsCacheStats == NULL )
     {
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        /* coverity[misra_c_2012_rule_21_6_violation]. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE,
-                           "AT+CDNSGIP=%u,\"%s\",0,10000", pdn2cid(contextId), pcHostName );
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQueryDns );
-
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
-        {
-            LogError( ( "Cellular_GetHostByName: couldn't resolve host name" ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-            PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
-        }
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
 
-    /* URC handler calls the callback to unblock this function. */
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        if( xQueueReceive( pModuleContext->pktDnsQueue, &dnsQueryResult,
-                           pdMS_TO_TICKS( DNS_QUERY_TIMEOUT_MS ) ) == pdTRUE )
-        {
-            if( dnsQueryResult != CELLULAR_DNS_QUERY_SUCCESS )
-            {
-                cellularStatus = CELLULAR_UNKNOWN;
-            }
-        }
-        else
-        {
-            ( void ) registerDnsEventCallback( pModuleContext, NULL, NULL );
-            cellularStatus = CELLULAR_TIMEOUT;
-        }
-
-        PlatformMutex_Unlock( &pModuleContext->dnsQueryMutex );
+        ( void ) xSemaphoreTake( pModuleContext->dnsCacheLock, portMAX_DELAY );
+        *pDnsCacheStats = pModuleContext->dnsCacheStats;
+        ( void ) xSemaphoreGive( pModuleContext->dnsCacheLock );
     }
 
     return cellularStatus;
@@ -47,6 +47,9 @@ static void _Cellular_ProcessPsmPowerDown( CellularContext_t * pContext,
                                            char * pInputLine );
 static void _Cellular_ProcessModemRdy( CellularContext_t * pContext,
                                        char * pInputLine );
+static void _Cellular_ProcessModemReboot( CellularContext_t * pContext,
+                                          char * pInputLine );
+static void _invalidateModemState( const CellularContext_t * pContext );
 static void _Cellular_ProcessSocketOpen( CellularContext_t * pContext,
                                          char * pInputLine );
 static void _Cellular_ProcessSocketurc( CellularContext_t * pContext,
@@ -60,11 +63,18 @@ static void _Cellular_ProcessPdnStatus(CellularContext_t* pContext, char* pInput
 static void _Cellular_ProcessSocketDataInd(CellularContext_t* pContext, char* pInputLine);
 static void _Cellular_ProcessSocketState(CellularContext_t* pContext, char* pInputLine);
 static void _Cellular_ProcessSocketUrc(CellularContext_t* pContext, char* pInputLine); 
-static void _informDataReadyToUpperLayer(CellularSocketContext_t* pSocketData);
+static void _Cellular_ProcessDnsGip( CellularContext_t * pContext,
+                                     char * pInputLine );
+static void _informDataReadyToUpperLayer(const CellularContext_t* pContext, CellularSocketContext_t* pSocketData);
+static CellularATError_t _socketDataReady(CellularContext_t* pContext, int32_t socketId);
+static CellularPktStatus_t _parseSocketUrcAct( const CellularContext_t * pContext,
+                                               char * pUrcStr );
 
 /*-----------------------------------------------------------*/
 
-/* Try to Keep this map in Alphabetical order. */
+/* The common library looks up the token before ':' with a binary search
+ * over this map. Keep it sorted in strcmp order, and keep each key exactly
+ * the URC token, without the '+' and with no trailing characters. */
 /* FreeRTOS Cellular Common Library porting interface. */
 /* coverity[misra_c_2012_rule_8_7_violation] */
 CellularAtParseTokenMap_t CellularUrcHandlerTable[] =
@@ -73,7 +83,8 @@ CellularAtParseTokenMap_t CellularUrcHandlerTable[] =
     { "CADATAIND",              _Cellular_ProcessSocketDataInd },
     { "CAOPEN",                 _Cellular_ProcessSocketOpen    },
     { "CASTATE",                _Cellular_ProcessSocketState   },
-    { "CAURC " ,                _Cellular_ProcessSocketUrc     },
+    { "CAURC",                  _Cellular_ProcessSocketUrc     },
+    { "CDNSGIP",                _Cellular_ProcessDnsGip        },
     { "CEREG",                  Cellular_CommonUrcProcessCereg },
     { "CGREG",                  Cellular_CommonUrcProcessCgreg },
     { "CPIN",                   _Cellular_ProcessSimstat       },
@@ -82,7 +93,7 @@ CellularAtParseTokenMap_t CellularUrcHandlerTable[] =
     { "CSQ",                    _Cellular_ProcessIndication    },
     { "NORMAL POWER DOWN",      _Cellular_ProcessPowerDown     },
     { "PSUTTZ",                _Cellular_ProcessModemRdy       },
-    { "RDY",                    _Cellular_ProcessModemRdy      },
+    { "RDY",                    _Cellular_ProcessModemReboot   },
 };
 
 /* FreeRTOS Cellular Common Library porting interface. */
@@ -95,6 +106,8 @@ static void _Cellular_ProcessSocketUrc(CellularContext_t* pContext, char* pInput
     /*Handling: +CAURC: "buffer full"*/
     char* pUrcStr = NULL;
     char* pToken = NULL;
+    int32_t socketId = -1;
+    int32_t dataLength = 0;
 
     CellularPktStatus_t         pktStatus = CELLULAR_PKT_STATUS_OK;
     CellularATError_t           atCoreStatus = CELLULAR_AT_SUCCESS;
@@ -112,17 +125,40 @@ static void _Cellular_ProcessSocketUrc(CellularContext_t* pContext, char* pInput
         goto err;
 
     atCoreStatus = Cellular_ATGetNextTok(&pUrcStr, &pToken);
+    if (atCoreStatus == CELLULAR_AT_SUCCESS)
+        atCoreStatus = Cellular_ATRemoveAllDoubleQuote(pToken);
     if (atCoreStatus != CELLULAR_AT_SUCCESS)
         goto err;
 
     if( strcmp( pToken, "recv") == 0 )
     {
-        CellularLogError("Socket notify: recv: %s", pUrcStr);
+        /* Sockets are opened in buffer mode (AT+CAOPEN without <recv_mode>)
+         * and the data is read with AT+CARECV, as after +CADATAIND. */
+        atCoreStatus = Cellular_ATGetNextTok(&pUrcStr, &pToken);
+        if (atCoreStatus == CELLULAR_AT_SUCCESS)
+            atCoreStatus = Cellular_ATStrtoi(pToken, 10, &socketId);
+        if (atCoreStatus == CELLULAR_AT_SUCCESS)
+            atCoreStatus = Cellular_ATGetNextTok(&pUrcStr, &pToken);
+        if (atCoreStatus == CELLULAR_AT_SUCCESS)
+            atCoreStatus = Cellular_ATStrtoi(pToken, 10, &dataLength);
+        if (atCoreStatus != CELLULAR_AT_SUCCESS)
+            goto err;
+
+        CellularLogDebug("Socket notify: recv %d bytes on socket %d", dataLength, socketId);
+        atCoreStatus = _socketDataReady(pContext, socketId);
+        if (atCoreStatus != CELLULAR_AT_SUCCESS)
+            goto err;
     }
     else if (strcmp(pToken, "buffer full") == 0)
     {
         CellularLogError("Socket notify: Buffer Full");
     }
+    else if (strcmp(pToken, "pdpdeact") == 0)
+    {
+        /*Handling: +CAURC: "pdpdeact",<pdpidx>*/
+        if (_parseSocketUrcAct(pContext, pUrcStr) != CELLULAR_PKT_STATUS_OK)
+            goto err;
+    }
     else
     {
         CellularLogError("Socket notify: %s", pToken);
@@ -199,14 +235,7 @@ static void _Cellular_ProcessSocketState(CellularContext_t* pContext, char* pInp
     CellularLogDebug("Socket %d. change state: %d", socketId, socketState);
 
     /* Indicate the upper layer about the socket close. */
-    if (pSocketData->closedCallback != NULL)
-    {
-        pSocketData->closedCallback(pSocketData, pSocketData->pClosedCallbackContext);
-    }
-    else
-    {
-        CellularLogInfo("_parseSocketUrc: Socket close callback not set!!");
-    }
+    _Cellular_SocketCallback(pContext, CALLBACK_SOCKET_CLOSED, pSocketData, CELLULAR_URC_SOCKET_OPENED);
     return;
 
 err:
@@ -228,6 +257,8 @@ static void _Cellular_ProcessPdnStatus(CellularContext_t* pContext, char* pInput
     cellularModuleContext_t* pSimContext = NULL;
     int32_t                     cid = 0;
     int                         contextId;
+    bool                        notifyWorker = false;
+    const cellularWorkerJob_t   job = { WORKER_JOB_PDN_TIMER, NULL, 0, NULL };
 
     if (pContext == NULL)
     {
@@ -252,7 +283,7 @@ static void _Cellular_ProcessPdnStatus(CellularContext_t* pContext, char* pInput
 
     atCoreStatus = Cellular_ATStrtoi(pIndex, 10, &cid);
     contextId = cid2pdn(cid);
-    if (atCoreStatus != CELLULAR_AT_SUCCESS || _Cellular_IsValidPdn(contextId) != CELLULAR_SUCCESS)
+    if (atCoreStatus != CELLULAR_AT_SUCCESS || _Cellular_IsValidPdn(contextId) != CELLULAR_SUCCESS || cid > CELLULAR_CID_MAX)
         goto err2;
 
     pSimContext = (cellularModuleContext_t*)pContext->pModueContext;
@@ -268,8 +299,25 @@ static void _Cellular_ProcessPdnStatus(CellularContext_t* pContext, char* pInput
 
     CellularLogInfo("Pdp-%s Info: status=%s", pIndex, pStatus);
 
-    cellularModuleContext_t* pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
-    xEventGroupSetBits(pSimContex->pdnEvent, EVENT_BIT_PDN_ACT);
+    _Cellular_PdnStateUpdate(pSimContext, (uint8_t)cid, (strcmp(pStatus, "ACTIVE") == 0));
+
+    (void)xSemaphoreTake(pSimContext->pdnLock, portMAX_DELAY);
+
+    if (pSimContext->pdnContexts[cid].activating && !pSimContext->pdnContexts[cid].reported)
+    {
+        /* Cellular_ActivatePdnAsync completes in the worker, it reads the address. */
+        pSimContext->pdnContexts[cid].reported = true;
+        pSimContext->pdnContexts[cid].reportTick = xTaskGetTickCount();
+        notifyWorker = true;
+    }
+
+    (void)xSemaphoreGive(pSimContext->pdnLock);
+    xEventGroupSetBits(pSimContext->pdnEvent, EVENT_BIT_PDN_ACT | PDN_EVENT_BIT(cid));
+
+    if (notifyWorker)
+    {
+        (void)_Cellular_PostWorkerJob(pSimContext, &job);
+    }
 
     return;
 
@@ -293,7 +341,6 @@ static void _Cellular_ProcessSocketDataInd(CellularContext_t* pContext, char* pI
 
     CellularPktStatus_t         pktStatus = CELLULAR_PKT_STATUS_OK;
     CellularATError_t           atCoreStatus = CELLULAR_AT_SUCCESS;
-    CellularSocketContext_t* pSocketData = NULL;
 
     if (pContext == NULL || pInputLine == NULL)
     {
@@ -315,8 +362,32 @@ static void _Cellular_ProcessSocketDataInd(CellularContext_t* pContext, char* pI
     if (atCoreStatus != CELLULAR_AT_SUCCESS)
         goto err;
 
-//    if (!IsValidSockID(socketId))
-//        goto err;
+    atCoreStatus = _socketDataReady(pContext, socketId);
+
+    if (atCoreStatus == CELLULAR_SUCCESS)
+        return;
+
+err:
+    _Cellular_TranslateAtCoreStatus(atCoreStatus);
+    CellularLogDebug("SocketDataInd process failure");
+}
+
+/*-----------------------------------------------------------*/
+
+/* Data is waiting in the modem for socketId, from +CADATAIND or +CAURC: "recv". */
+static CellularATError_t _socketDataReady(CellularContext_t* pContext, int32_t socketId)
+{
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+    CellularSocketContext_t* pSocketData = NULL;
+    cellularModuleContext_t* pSimContex = NULL;
+    cellularSocketRecvStats_t* pRecvStats = NULL;
+    bool notify = false;
+
+    if (!IsValidSockID(socketId))
+    {
+        CellularLogError("Error in processing Socket Index %d", socketId);
+        return CELLULAR_AT_ERROR;
+    }
 
     pSocketData = _Cellular_GetSocketData(pContext, socketId);
 
@@ -325,11 +396,37 @@ static void _Cellular_ProcessSocketDataInd(CellularContext_t* pContext, char* pI
         if (pSocketData->dataMode == CELLULAR_ACCESSMODE_BUFFER)
         {
             /* Data received indication in buffer mode, need to fetch the data. */
-            CellularLogDebug("Data Received on socket Conn Id %d", socketId);
-            cellularModuleContext_t* pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
-            xEventGroupSetBits(pSimContex->pdnEvent, EVENT_BIT_RX_DATA);
+            pSimContex = (cellularModuleContext_t*)pContext->pModueContext;
+            pRecvStats = &pSimContex->socketData[socketId].recvStats;
+            pRecvStats->dataIndications++;
+
+            /* Edge triggered. The RX bit stays set until +CARECV: 0, and with an
+             * RX ring until the ring is empty too, so the application was told
+             * already and hasn't drained the socket. */
+            xSemaphoreTake(pSimContex->socketLock, portMAX_DELAY);
+            pSimContex->socketData[socketId].rxModemData = true;
+            notify = ((xEventGroupGetBits(pSimContex->rxDataEvent) & RX_DATA_EVENT_BIT(socketId)) == 0U);
+
+            if (notify)
+            {
+                xEventGroupSetBits(pSimContex->rxDataEvent, RX_DATA_EVENT_BIT(socketId));
+            }
+
+            xSemaphoreGive(pSimContex->socketLock);
 
-            _informDataReadyToUpperLayer(pSocketData);
+            if (notify)
+            {
+                CellularLogDebug("Data Received on socket Conn Id %d", socketId);
+                _informDataReadyToUpperLayer(pContext, pSocketData);
+            }
+            else
+            {
+                pRecvStats->dataIndCoalesced++;
+                CellularLogDebug("Data Received on socket Conn Id %d, not drained yet", socketId);
+            }
+
+            /* Prefetch into the socket RX ring if the application enabled one. */
+            _Cellular_RequestRxFetch(pContext, pSimContex, (uint32_t)socketId);
         }
     }
     else
@@ -337,18 +434,14 @@ static void _Cellular_ProcessSocketDataInd(CellularContext_t* pContext, char* pI
         atCoreStatus = CELLULAR_AT_ERROR;
     }
 
-    if (atCoreStatus == CELLULAR_SUCCESS)
-        return;
-
-err:
-    _Cellular_TranslateAtCoreStatus(atCoreStatus);
-    CellularLogDebug("SocketDataInd process failure");
+    return atCoreStatus;
 }
 
 /*-----------------------------------------------------------*/
 
 /* internal function of _parseSocketOpen to reduce complexity. */
-static CellularPktStatus_t _parseSocketOpenNextTok( const char * pToken,
+static CellularPktStatus_t _parseSocketOpenNextTok( const CellularContext_t * pContext,
+                                                    const char * pToken,
                                                     uint32_t sockIndex,
                                                     CellularSocketContext_t * pSocketData )
 {
@@ -372,23 +465,8 @@ static CellularPktStatus_t _parseSocketOpenNextTok( const char * pToken,
         }
 
         /* Indicate the upper layer about the socket open status. */
-        if( pSocketData->openCallback != NULL )
-        {
-            if( sockStatus != 0 )
-            {
-                pSocketData->openCallback( CELLULAR_URC_SOCKET_OPEN_FAILED,
-                                           pSocketData, pSocketData->pOpenCallbackContext );
-            }
-            else
-            {
-                pSocketData->openCallback( CELLULAR_URC_SOCKET_OPENED,
-                                           pSocketData, pSocketData->pOpenCallbackContext );
-            }
-        }
-        else
-        {
-            LogError( ( "_parseSocketOpen: Socket open callback for conn %d is not set!!", sockIndex ) );
-        }
+        _Cellular_SocketCallback( pContext, CALLBACK_SOCKET_OPEN, pSocketData,
+                                  ( sockStatus != 0 ) ? CELLULAR_URC_SOCKET_OPEN_FAILED : CELLULAR_URC_SOCKET_OPENED );
     }
 
     pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
@@ -456,7 +534,7 @@ static void _Cellular_ProcessSocketOpen( CellularContext_t * pContext,
 
                 if( atCoreStatus == CELLULAR_AT_SUCCESS )
                 {
-                    pktStatus = _parseSocketOpenNextTok( pToken, sockIndex, pSocketData );
+                    pktStatus = _parseSocketOpenNextTok( pContext, pToken, sockIndex, pSocketData );
                 }
             }
             else
@@ -628,17 +706,11 @@ static void _Cellular_ProcessIndication( CellularContext_t * pContext,
 
 /*-----------------------------------------------------------*/
 
-static void _informDataReadyToUpperLayer( CellularSocketContext_t * pSocketData )
+static void _informDataReadyToUpperLayer( const CellularContext_t * pContext,
+                                          CellularSocketContext_t * pSocketData )
 {
     /* Indicate the upper layer about the data reception. */
-    if( ( pSocketData != NULL ) && ( pSocketData->dataReadyCallback != NULL ) )
-    {
-        pSocketData->dataReadyCallback( pSocketData, pSocketData->pDataReadyCallbackContext );
-    }
-    else
-    {
-        LogError( ( ( "_parseSocketUrc: Data ready callback not set!!" ) ) );
-    }
+    _Cellular_SocketCallback( pContext, CALLBACK_SOCKET_DATA_READY, pSocketData, CELLULAR_URC_SOCKET_OPENED );
 }
 
 /*-----------------------------------------------------------*/
@@ -684,7 +756,7 @@ static CellularPktStatus_t _parseSocketUrcRecv( const CellularContext_t * pConte
             {
                 /* Data received indication in buffer mode, need to fetch the data. */
                 LogDebug( ( "Data Received on socket Conn Id %d", sockIndex ) );
-                _informDataReadyToUpperLayer( pSocketData );
+                _informDataReadyToUpperLayer( pContext, pSocketData );
             }
         }
         else
@@ -744,14 +816,7 @@ static CellularPktStatus_t _parseSocketUrcClosed( const CellularContext_t * pCon
             LogDebug( ( "Socket closed. Conn Id %d", sockIndex ) );
 
             /* Indicate the upper layer about the socket close. */
-            if( pSocketData->closedCallback != NULL )
-            {
-                pSocketData->closedCallback( pSocketData, pSocketData->pClosedCallbackContext );
-            }
-            else
-            {
-                LogInfo( ( "_parseSocketUrc: Socket close callback not set!!" ) );
-            }
+            _Cellular_SocketCallback( pContext, CALLBACK_SOCKET_CLOSED, pSocketData, CELLULAR_URC_SOCKET_OPENED );
         }
         else
         {
@@ -776,6 +841,7 @@ static CellularPktStatus_t _parseSocketUrcAct( const CellularContext_t * pContex
     char * pToken = NULL;
     char * pLocalUrcStr = pUrcStr;
     uint8_t contextId = 0;
+    cellularModuleContext_t * pModuleContext = NULL;
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
 
@@ -795,6 +861,12 @@ static CellularPktStatus_t _parseSocketUrcAct( const CellularContext_t * pContex
             if( _Cellular_IsValidPdn( contextId ) == CELLULAR_SUCCESS )
             {
                 LogDebug( ( "PDN deactivated. Context Id %d", contextId ) );
+
+                if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+                {
+                    _Cellular_PdnStateUpdate( pModuleContext, ( uint8_t ) tempValue, false );
+                }
+
                 /* Indicate the upper layer about the PDN deactivate. */
                 _Cellular_PdnEventCallback( pContext, CELLULAR_URC_EVENT_PDN_DEACTIVATED, contextId );
             }
@@ -821,8 +893,12 @@ static CellularPktStatus_t _parseSocketUrcDns( const CellularContext_t * pContex
                                                char * pUrcStr )
 {
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
     cellularModuleContext_t * pModuleContext = NULL;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    char * pToken = NULL, * pHostName = NULL;
+    cellularDnsResult_t dnsResult = { 0 };
+    const cellularDnsResult_t * pDnsResult = NULL;
 
     if( pContext == NULL )
     {
@@ -842,17 +918,56 @@ static CellularPktStatus_t _parseSocketUrcDns( const CellularContext_t * pContex
         }
     }
 
+    /* 1,<host>,<ip>[,<ip>...] or 0,<error code>. Quotes are removed already. */
     if( pktStatus == CELLULAR_PKT_STATUS_OK )
     {
-        if( pModuleContext->dnsEventCallback != NULL )
+        atCoreStatus = Cellular_ATGetNextTok( &pUrcStr, &pToken );
+
+        if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( strcmp( pToken, "1" ) == 0 ) )
         {
-            pModuleContext->dnsEventCallback( pModuleContext, pUrcStr, pModuleContext->pDnsUsrData );
+            atCoreStatus = Cellular_ATGetNextTok( &pUrcStr, &pHostName );
+
+            while( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( pUrcStr != NULL ) && ( *pUrcStr != '\0' ) &&
+                   ( dnsResult.addressCount < CELLULAR_SIM70X0_DNS_MAX_ADDRESSES ) )
+            {
+                atCoreStatus = Cellular_ATGetNextTok( &pUrcStr, &pToken );
+
+                if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( strlen( pToken ) <= CELLULAR_IP_ADDRESS_MAX_SIZE ) )
+                {
+                    ( void ) strncpy( dnsResult.addresses[ dnsResult.addressCount ], pToken, CELLULAR_IP_ADDRESS_MAX_SIZE + 1U );
+                    dnsResult.addressCount++;
+                }
+            }
+
+            if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsResult.addressCount == 0U ) )
+            {
+                atCoreStatus = CELLULAR_AT_ERROR;
+            }
+
+            pDnsResult = &dnsResult;
+        }
+        else if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            LogDebug( ( "_parseSocketUrcDns: DNS error %s", ( pUrcStr != NULL ) ? pUrcStr : "" ) );
         }
         else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+
+        if( atCoreStatus != CELLULAR_AT_SUCCESS )
+        {
+            pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
+        }
+        else if( _Cellular_DnsQueryComplete( pModuleContext, pHostName, pDnsResult ) == false )
         {
             LogDebug( ( "_parseSocketUrcDns: spurious DNS response!!" ) );
             pktStatus = CELLULAR_PKT_STATUS_INVALID_DATA;
         }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
     }
 
     return pktStatus;
@@ -860,6 +975,51 @@ static CellularPktStatus_t _parseSocketUrcDns( const CellularContext_t * pContex
 
 /*-----------------------------------------------------------*/
 
+/* Cellular common prototype. */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+static void _Cellular_ProcessDnsGip( CellularContext_t * pContext,
+                                     char * pInputLine )
+{
+    char * pUrcStr = NULL;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+
+    if( pContext == NULL )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_INVALID_HANDLE;
+    }
+    else if( pInputLine == NULL )
+    {
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+    }
+    else
+    {
+        pUrcStr = pInputLine;
+        atCoreStatus = Cellular_ATRemoveAllDoubleQuote( pUrcStr );
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATRemoveLeadingWhiteSpaces( &pUrcStr );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            pktStatus = _parseSocketUrcDns( pContext, pUrcStr );
+        }
+        else
+        {
+            pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
+        }
+    }
+
+    if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    {
+        LogDebug( ( "_Cellular_ProcessDnsGip: parse failure" ) );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 /* Cellular common prototype. */
 /* coverity[misra_c_2012_rule_8_13_violation] */
 static void _Cellular_ProcessSocketurc( CellularContext_t * pContext,
@@ -965,6 +1125,7 @@ static void _Cellular_ProcessPowerDown( CellularContext_t * pContext,
     else
     {
         LogDebug( ( "_Cellular_ProcessPowerDown: Modem Power down event received" ) );
+        _invalidateModemState( pContext );
         _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_POWERED_DOWN );
     }
 }
@@ -1013,6 +1174,36 @@ static void _Cellular_ProcessModemRdy( CellularContext_t * pContext,
 
 /*-----------------------------------------------------------*/
 
+/* Cellular common prototype. */
+/* coverity[misra_c_2012_rule_8_13_violation] */
+static void _Cellular_ProcessModemReboot( CellularContext_t * pContext,
+                                          char * pInputLine )
+{
+    /* RDY follows a reset of the modem, which deactivates every PDN context
+     * and drops the DNS queries in progress. */
+    if( pContext != NULL )
+    {
+        _invalidateModemState( pContext );
+    }
+
+    _Cellular_ProcessModemRdy( pContext, pInputLine );
+}
+
+/*-----------------------------------------------------------*/
+
+static void _invalidateModemState( const CellularContext_t * pContext )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        _Cellular_PdnStateInvalidate( pModuleContext );
+        _Cellular_DnsQueryReset( pModuleContext );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 /* Cellular common prototype. */
 /* coverity[misra_c_2012_rule_8_13_violation] */
 CellularPktStatus_t _Cellular_ParseSimstat( char * pInputStr,